@@ -0,0 +1,50 @@
+#ifndef BENCHOPTIONS_H_
+#define BENCHOPTIONS_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/*
+ * The options which the benchmarks are run with, as parsed from the command line.
+ */
+struct BenchOptions {
+	// The benchmarks to run (startup, latency, contention and/or lifecycle)
+	std::vector<std::string> benchmarks = {"startup", "latency", "contention", "lifecycle"};
+	// The number of beans to generate (one graph per entry)
+	std::vector<std::size_t> beans = {1000, 10000, 100000};
+	// The shapes of the graphs to generate
+	std::vector<std::string> shapes = {"chain", "diamond", "layers"};
+	// The number of beans that each configuration provides
+	std::size_t beansPerConfig = 4;
+	// The width of the diamonds/layers
+	std::size_t width = 8;
+	// The number of beans that each configuration of a layer requires
+	std::size_t fanIn = 3;
+	// The number of threads to assemble the context with (one run per entry)
+	std::vector<std::size_t> threads = {1};
+	// The order in which the configurations are registered (forward, reverse or shuffled)
+	std::string order = "shuffled";
+	// The number of times that each run is repeated (the median of which is reported)
+	std::size_t reps = 3;
+	// The seed for generating the graphs and shuffling the configurations
+	unsigned int seed = 42;
+	// The number of threads retrieving beans at the same time (one run per entry)
+	std::vector<std::size_t> latencyThreads = {1, 2, 4, 8};
+	// The number of beans each thread retrieves (and times) per run
+	std::size_t calls = 200000;
+	// The number of contexts to create and tear down
+	std::size_t cycles = 1000;
+	// Whether the bean statistics are counted while retrieving
+	bool statistics = false;
+	// The file to write the Chrome trace of the benchmarks to (not traced if empty)
+	std::string trace;
+	// The file to write the report to (stdout if empty)
+	std::string output;
+};
+
+}
+
+#endif /* BENCHOPTIONS_H_ */
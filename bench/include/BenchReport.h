@@ -0,0 +1,85 @@
+#ifndef BENCHREPORT_H_
+#define BENCHREPORT_H_
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/*
+ * The result of a single benchmark run: the parameters which the benchmark was run with, and the metrics
+ * that it measured.
+ */
+struct BenchResult {
+	// The name of the benchmark
+	std::string benchmark;
+	// The parameters of the run, in the order in which they were added
+	std::vector<std::pair<std::string, std::string>> params;
+	// The metrics of the run, in the order in which they were added
+	std::vector<std::pair<std::string, double>> metrics;
+
+	/*
+	 * Add a parameter.
+	 *
+	 * @param name const std::string& the name of the parameter
+	 * @param value const std::string& the value of the parameter
+	 *
+	 * @return BenchResult& this result
+	 */
+	BenchResult& param(const std::string& name, const std::string& value);
+
+	/*
+	 * Add a numeric parameter.
+	 *
+	 * @param name const std::string& the name of the parameter
+	 * @param value std::size_t the value of the parameter
+	 *
+	 * @return BenchResult& this result
+	 */
+	BenchResult& param(const std::string& name, std::size_t value);
+
+	/*
+	 * Add a metric.
+	 *
+	 * @param name const std::string& the name of the metric (including its unit, i.e.: "assemble_ms")
+	 * @param value double the measured value
+	 *
+	 * @return BenchResult& this result
+	 */
+	BenchResult& metric(const std::string& name, double value);
+};
+
+/*
+ * Collection of the results of all benchmark runs, which can be written as JSON in the form of:
+ *
+ * 		{"results": [{"benchmark": "startup", "params": {"shape": "chain", ...}, "metrics": {"assemble_ms": 1.5, ...}}, ...]}
+ */
+class BenchReport {
+
+public:
+	/*
+	 * Add a new result to the report.
+	 *
+	 * @param benchmark const std::string& the name of the benchmark
+	 *
+	 * @return BenchResult& the result, to be filled in (valid until the next result is added)
+	 */
+	BenchResult& addResult(const std::string& benchmark);
+
+	/*
+	 * Write the report as JSON.
+	 *
+	 * @param os std::ostream& the stream to write to
+	 */
+	void write(std::ostream& os) const;
+
+private:
+	// All results, in the order in which they were added
+	std::vector<BenchResult> m_results;
+};
+
+}
+
+#endif /* BENCHREPORT_H_ */
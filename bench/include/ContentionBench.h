@@ -0,0 +1,24 @@
+#ifndef CONTENTIONBENCH_H_
+#define CONTENTIONBENCH_H_
+
+#include "BenchOptions.h"
+#include "BenchReport.h"
+
+namespace bench {
+
+/*
+ * Run the contention benchmark: for every number of threads, have all threads retrieve and use a bean which is
+ * cheap to duplicate but not safe to share (a random number generator) at the same time. Compares sharing a single
+ * instance (from a SingletonBeanCreator, guarding every use with a mutex) with each thread having its own instance
+ * (from a ThreadLocalBeanCreator, without any synchronization), reporting the throughput of all threads together.
+ * Likewise compares retrieving a smart singleton through a std::shared_ptr with an IntrusivePtr (whose count lives
+ * within the bean), as well as with an IntrusivePtr with a non-atomic count (on a single thread only).
+ *
+ * @param options const BenchOptions& the options
+ * @param report BenchReport& the report to add the results to
+ */
+void runContentionBenchmark(const BenchOptions& options, BenchReport& report);
+
+}
+
+#endif /* CONTENTIONBENCH_H_ */
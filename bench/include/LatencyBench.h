@@ -0,0 +1,22 @@
+#ifndef LATENCYBENCH_H_
+#define LATENCYBENCH_H_
+
+#include "BenchOptions.h"
+#include "BenchReport.h"
+
+namespace bench {
+
+/*
+ * Run the latency benchmark: for every kind of bean (by creator), and every number of threads, have all threads
+ * retrieve the same bean from the same manager at the same time, timing every single retrieval. Reports the
+ * percentiles of the latencies of all threads together, along with those of retrieving the same bean directly
+ * (without the manager), as the baseline. A large read-only value bean is retrieved both by copy and by const reference.
+ *
+ * @param options const BenchOptions& the options
+ * @param report BenchReport& the report to add the results to
+ */
+void runLatencyBenchmark(const BenchOptions& options, BenchReport& report);
+
+}
+
+#endif /* LATENCYBENCH_H_ */
@@ -0,0 +1,114 @@
+#ifndef LATENCYHISTOGRAM_H_
+#define LATENCYHISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+/*
+ * Histogram of latencies (in nanoseconds), with logarithmic buckets that are each split into linear sub-buckets.
+ * Every power of two is covered by SUB_BUCKETS sub-buckets, so that any recorded value is known to within
+ * 1/SUB_BUCKETS (~3%) regardless of its magnitude, while recording is only a few instructions without any
+ * allocation. Each thread is expected to record into its own histogram, which are then merged.
+ */
+class LatencyHistogram {
+
+public:
+	// CTOR
+	LatencyHistogram();
+
+	/*
+	 * Record a single latency.
+	 *
+	 * @param ns std::uint64_t the latency in nanoseconds
+	 */
+	void record(std::uint64_t ns) {
+		m_counts[bucketIndex(ns)]++;
+		m_count++;
+		m_sum += ns;
+		if (ns > m_max)
+			m_max = ns;
+	}
+
+	/*
+	 * Add all latencies recorded by the other histogram to this one.
+	 *
+	 * @param other const LatencyHistogram& the histogram to merge
+	 */
+	void merge(const LatencyHistogram& other);
+
+	/*
+	 * Get the latency below which the given fraction of all recorded latencies falls.
+	 *
+	 * @param fraction double the fraction (i.e.: 0.99 for the 99th percentile)
+	 *
+	 * @return std::uint64_t the lowest latency of the bucket holding the percentile (or 0 if nothing was recorded)
+	 */
+	std::uint64_t getPercentile(double fraction) const;
+
+	/*
+	 * Get the number of recorded latencies.
+	 *
+	 * @return std::uint64_t the number of latencies
+	 */
+	std::uint64_t getCount() const;
+
+	/*
+	 * Get the mean of all recorded latencies.
+	 *
+	 * @return double the mean (or 0 if nothing was recorded)
+	 */
+	double getMean() const;
+
+	/*
+	 * Get the highest recorded latency (exact).
+	 *
+	 * @return std::uint64_t the highest latency
+	 */
+	std::uint64_t getMax() const;
+
+private:
+	// The number of sub-buckets per power of two
+	static constexpr std::uint64_t SUB_BUCKETS = 32;
+	// log2(SUB_BUCKETS)
+	static constexpr int SUB_BUCKET_BITS = 5;
+
+	// The number of latencies in each bucket
+	std::vector<std::uint64_t> m_counts;
+	// The number of recorded latencies
+	std::uint64_t m_count = 0;
+	// The sum of all recorded latencies
+	std::uint64_t m_sum = 0;
+	// The highest recorded latency
+	std::uint64_t m_max = 0;
+
+	/*
+	 * Get the bucket of the latency. Values below 2 * SUB_BUCKETS each have their own bucket, above that each
+	 * power of two is split into SUB_BUCKETS.
+	 *
+	 * @param ns std::uint64_t the latency
+	 *
+	 * @return std::size_t the index of the bucket
+	 */
+	static std::size_t bucketIndex(std::uint64_t ns) {
+		if (ns < 2 * SUB_BUCKETS)
+			return std::size_t(ns);
+		const int shift = 63 - __builtin_clzll(ns) - SUB_BUCKET_BITS;
+		return std::size_t((shift + 1) * SUB_BUCKETS + ((ns >> shift) - SUB_BUCKETS));
+	}
+
+	/*
+	 * Get the lowest latency which falls within the bucket.
+	 *
+	 * @param index std::size_t the index of the bucket
+	 *
+	 * @return std::uint64_t the lowest latency of the bucket
+	 */
+	static std::uint64_t bucketValue(std::size_t index);
+};
+
+}
+
+#endif /* LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,23 @@
+#ifndef LIFECYCLEBENCH_H_
+#define LIFECYCLEBENCH_H_
+
+#include "BenchOptions.h"
+#include "BenchReport.h"
+
+namespace bench {
+
+/*
+ * Run the lifecycle benchmark: repeatedly create a context with a number of smart singleton beans, retrieve each of
+ * them and tear the context down again. Compares the SmartSingletonBeanCreator (one instance per creator, made with a
+ * single allocation) with the same creator constructing the instance separately from its reference count, and with a
+ * single instance shared by the entire process (never released), reporting the allocations per cycle along with the
+ * memory which remains allocated once all contexts are gone.
+ *
+ * @param options const BenchOptions& the options
+ * @param report BenchReport& the report to add the results to
+ */
+void runLifecycleBenchmark(const BenchOptions& options, BenchReport& report);
+
+}
+
+#endif /* LIFECYCLEBENCH_H_ */
@@ -0,0 +1,34 @@
+#ifndef MEMORYTRACKER_H_
+#define MEMORYTRACKER_H_
+
+#include <cstddef>
+
+namespace bench {
+
+/*
+ * Snapshot of the heap usage of the process, as tracked through the (replaced) global operator new/delete.
+ */
+struct MemoryStats {
+	// Number of bytes currently allocated
+	std::size_t currentBytes;
+	// Highest number of bytes allocated at any one time since the last reset
+	std::size_t peakBytes;
+	// Number of allocations performed since the last reset
+	std::size_t numAllocations;
+};
+
+/*
+ * Reset the peak to the current usage, and the number of allocations to 0.
+ */
+void resetMemoryStats();
+
+/*
+ * Get the current heap usage.
+ *
+ * @return MemoryStats the heap usage
+ */
+MemoryStats getMemoryStats();
+
+}
+
+#endif /* MEMORYTRACKER_H_ */
@@ -0,0 +1,21 @@
+#ifndef STARTUPBENCH_H_
+#define STARTUPBENCH_H_
+
+#include "BenchOptions.h"
+#include "BenchReport.h"
+
+namespace bench {
+
+/*
+ * Run the startup benchmark: for every combination of shape, number of beans and number of threads, build a
+ * context out of a generated graph of configurations, timing the registration, assembly, freezing, first access
+ * (creation) of every bean and the teardown, and tracking the peak heap usage.
+ *
+ * @param options const BenchOptions& the options
+ * @param report BenchReport& the report to add the results to
+ */
+void runStartupBenchmark(const BenchOptions& options, BenchReport& report);
+
+}
+
+#endif /* STARTUPBENCH_H_ */
@@ -0,0 +1,145 @@
+#ifndef SYNTHETICGRAPH_H_
+#define SYNTHETICGRAPH_H_
+
+#include <string>
+#include <vector>
+
+#include "corm/Context.h"
+
+namespace bench {
+
+/*
+ * A generated configuration: the beans that it requires, and the beans that it provides.
+ */
+struct SyntheticConfigSpec {
+	// The name of the configuration
+	std::string name;
+	// The names of the beans that the configuration requires
+	std::vector<std::string> resources;
+	// The names of the beans that the configuration provides
+	std::vector<std::string> beans;
+};
+
+/*
+ * A generated graph of configurations, which together form a context that can be assembled.
+ */
+struct SyntheticGraph {
+	// The shape of the graph
+	std::string shape;
+	// All configurations of the graph, such that each only depends on configurations that come before it
+	std::vector<SyntheticConfigSpec> configs;
+
+	/*
+	 * Get the total number of beans provided by the configurations.
+	 *
+	 * @return std::size_t the number of beans
+	 */
+	std::size_t getNumBeans() const;
+
+	/*
+	 * Get the total number of dependencies (resources) of the configurations.
+	 *
+	 * @return std::size_t the number of dependencies
+	 */
+	std::size_t getNumDependencies() const;
+};
+
+/*
+ * Generate a chain, where each configuration depends on the previous one (depth is the number of configurations).
+ *
+ * @param numBeans std::size_t the (approximate) number of beans to generate
+ * @param beansPerConfig std::size_t the number of beans that each configuration provides
+ *
+ * @return SyntheticGraph the graph
+ */
+SyntheticGraph generateChain(std::size_t numBeans, std::size_t beansPerConfig);
+
+/*
+ * Generate a chain of diamonds. Each diamond is a configuration, on which width configurations depend (fan-out),
+ * which in turn are all depended on by a single configuration (fan-in). Each diamond depends on the previous one.
+ *
+ * @param numBeans std::size_t the (approximate) number of beans to generate
+ * @param beansPerConfig std::size_t the number of beans that each configuration provides
+ * @param width std::size_t the number of configurations in the middle of each diamond
+ *
+ * @return SyntheticGraph the graph
+ */
+SyntheticGraph generateDiamonds(std::size_t numBeans, std::size_t beansPerConfig, std::size_t width);
+
+/*
+ * Generate layers of configurations, where each configuration depends on fanIn randomly chosen beans of the
+ * previous layer.
+ *
+ * @param numBeans std::size_t the (approximate) number of beans to generate
+ * @param beansPerConfig std::size_t the number of beans that each configuration provides
+ * @param width std::size_t the number of configurations per layer
+ * @param fanIn std::size_t the number of beans that each configuration requires
+ * @param seed unsigned int the seed for choosing the required beans
+ *
+ * @return SyntheticGraph the graph
+ */
+SyntheticGraph generateLayers(std::size_t numBeans, std::size_t beansPerConfig, std::size_t width, std::size_t fanIn,
+		unsigned int seed);
+
+/*
+ * The bean provided by generated configurations.
+ */
+struct SyntheticBean {
+	long value = 0;
+};
+
+/*
+ * Configuration which resolves all of the beans that it requires (into handles, without creating them), and then
+ * registers all of the beans that it provides (as singletons, only created on first access).
+ */
+class SyntheticConfiguration: public corm::BaseConfiguration {
+
+public:
+	// CTOR
+	SyntheticConfiguration(corm::BeanManager* manager, const SyntheticConfigSpec& spec);
+
+protected:
+	/*
+	 * Resolve the resources.
+	 */
+	virtual void postInit();
+
+	/*
+	 * Register the beans.
+	 */
+	virtual void provideBeans();
+
+private:
+	// The specification of the configuration
+	const SyntheticConfigSpec& m_spec;
+	// The resolved resources
+	std::vector<corm::BeanRef<SyntheticBean*>> m_resources;
+};
+
+/*
+ * Wrapper through which a generated configuration is registered with the context.
+ */
+class SyntheticConfigurationWrapper: public corm::ConfigurationWrapperInterface {
+
+public:
+	// CTOR, the spec must outlive the wrapper and the configuration
+	SyntheticConfigurationWrapper(corm::BeanManager* manager, const SyntheticConfigSpec& spec);
+
+	virtual std::string getName() const;
+	virtual bool areResourcesSatisfied();
+	virtual corm::BaseConfiguration* buildConfig();
+	virtual const std::vector<std::string>& getWaitingResources() const;
+	virtual const std::vector<std::string>& getBeanNames() const;
+
+private:
+	// The bean manager that holds the beans for the context
+	corm::BeanManager* m_beanManager;
+	// The specification of the configuration
+	const SyntheticConfigSpec& m_spec;
+	// The names of the resources that the configuration is still waiting on
+	std::vector<std::string> m_waitingResources;
+};
+
+}
+
+#endif /* SYNTHETICGRAPH_H_ */
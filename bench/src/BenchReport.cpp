@@ -0,0 +1,74 @@
+#include "BenchReport.h"
+#include "corm/Json.h"
+
+#include <cmath>
+#include <iomanip>
+
+namespace bench {
+
+/*
+ * Add the parameter
+ */
+BenchResult& BenchResult::param(const std::string& name, const std::string& value) {
+	params.emplace_back(name, value);
+	return *this;
+}
+
+/*
+ * Add the parameter as a string
+ */
+BenchResult& BenchResult::param(const std::string& name, std::size_t value) {
+	return param(name, std::to_string(value));
+}
+
+/*
+ * Add the metric
+ */
+BenchResult& BenchResult::metric(const std::string& name, double value) {
+	metrics.emplace_back(name, value);
+	return *this;
+}
+
+/*
+ * Add an empty result
+ */
+BenchResult& BenchReport::addResult(const std::string& benchmark) {
+	m_results.emplace_back();
+	m_results.back().benchmark = benchmark;
+	return m_results.back();
+}
+
+/*
+ * Write all results
+ */
+void BenchReport::write(std::ostream& os) const {
+	os << "{\"results\": [";
+	for (std::size_t r = 0; r < m_results.size(); r++) {
+		const BenchResult& result = m_results[r];
+		os << (r == 0 ? "\n" : ",\n") << "  {\"benchmark\": ";
+		corm::writeJsonString(os, result.benchmark);
+
+		os << ", \"params\": {";
+		for (std::size_t i = 0; i < result.params.size(); i++) {
+			os << (i == 0 ? "" : ", ");
+			corm::writeJsonString(os, result.params[i].first);
+			os << ": ";
+			corm::writeJsonString(os, result.params[i].second);
+		}
+
+		os << "}, \"metrics\": {";
+		for (std::size_t i = 0; i < result.metrics.size(); i++) {
+			os << (i == 0 ? "" : ", ");
+			corm::writeJsonString(os, result.metrics[i].first);
+			// JSON has no representation for infinity or NaN
+			if (std::isfinite(result.metrics[i].second))
+				os << ": " << std::setprecision(9) << result.metrics[i].second;
+			else
+				os << ": null";
+		}
+		os << "}}";
+	}
+	os << "\n]}" << std::endl;
+}
+
+}
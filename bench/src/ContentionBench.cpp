@@ -0,0 +1,155 @@
+#include "ContentionBench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "corm/BeanManager.h"
+
+namespace bench {
+
+/*
+ * The bean which is used: a (linear congruential) random number generator, the state of which changes with every use.
+ */
+struct RandomBean {
+	std::uint64_t state = 42;
+
+	std::uint64_t next() {
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return state >> 33;
+	}
+};
+
+/*
+ * The bean which is shared by reference counted pointer, counting its own references (atomically, so that it can be
+ * shared between threads) for the IntrusivePtr.
+ */
+struct CountedBean: public corm::RefCounted<CountedBean> {
+	std::uint64_t value = 42;
+};
+
+/*
+ * The bean which is shared by reference counted pointer within a single thread, counting its own references without
+ * atomic operations.
+ */
+struct LocalCountedBean: public corm::RefCounted<LocalCountedBean, corm::LocalRefCount> {
+	std::uint64_t value = 42;
+};
+
+/*
+ * Have the threads all retrieve and use the bean at the same time, timing the run as a whole.
+ *
+ * @template Use callable which retrieves and uses the bean, returning the number it drew
+ *
+ * @param numThreads std::size_t the number of threads
+ * @param calls std::size_t the number of times each thread uses the bean
+ * @param use Use the retrieval and use to time
+ *
+ * @return double the duration of the run, in seconds
+ */
+template<typename Use>
+static double timeUses(std::size_t numThreads, std::size_t calls, Use use) {
+	std::atomic<std::size_t> numReady(0);
+	std::atomic<std::uint64_t> checksum(0);
+
+	auto run = [&]() {
+		// Start all threads at the same time
+		numReady.fetch_add(1);
+		while (numReady.load() < numThreads)
+			std::this_thread::yield();
+
+		std::uint64_t sum = 0;
+		for (std::size_t i = 0; i < calls; i++)
+			sum += use();
+		checksum.fetch_add(sum);
+	};
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (std::size_t t = 1; t < numThreads; t++)
+		threads.emplace_back(run);
+	run();
+	for (std::thread& t: threads)
+		t.join();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * Add the throughput to the report.
+ *
+ * @param report BenchReport& the report
+ * @param creator const std::string& the creator of the bean
+ * @param numThreads std::size_t the number of threads
+ * @param calls std::size_t the number of uses per thread
+ * @param seconds double the duration of the run
+ */
+static void addContentionResult(BenchReport& report, const std::string& creator, std::size_t numThreads,
+		std::size_t calls, double seconds) {
+	const double totalCalls = double(calls) * double(numThreads);
+	report.addResult("contention")
+			.param("creator", creator)
+			.param("threads", numThreads)
+			.param("calls", calls)
+			.metric("total_ms", seconds * 1000.0)
+			.metric("ns_per_call", seconds * 1e9 / totalCalls)
+			.metric("calls_per_s", totalCalls / seconds);
+	std::cerr << "contention " << creator << " threads=" << numThreads << " done" << std::endl;
+}
+
+/*
+ * Run the shared and the thread local bean for all numbers of threads
+ */
+void runContentionBenchmark(const BenchOptions& options, BenchReport& report) {
+	corm::BeanStatistics::setEnabled(options.statistics);
+	corm::BeanManager manager;
+	manager.registerBean<RandomBean*>("contention.shared");
+	manager.registerBean<RandomBean*, corm::ThreadLocalBeanCreator<RandomBean*>>("contention.threadLocal");
+	manager.registerBean<std::shared_ptr<CountedBean>, corm::SmartSingletonBeanCreator<CountedBean>>("contention.sharedPtr");
+	manager.registerBean<corm::IntrusivePtr<CountedBean>, corm::SmartSingletonBeanCreator<CountedBean, corm::IntrusivePtr>>(
+			"contention.intrusive");
+	manager.registerBean<corm::IntrusivePtr<LocalCountedBean>,
+			corm::SmartSingletonBeanCreator<LocalCountedBean, corm::IntrusivePtr>>("contention.intrusiveLocal");
+	manager.freeze();
+
+	std::mutex sharedLock;
+	for (std::size_t numThreads: options.latencyThreads) {
+		numThreads = std::max<std::size_t>(1, numThreads);
+		addContentionResult(report, "SingletonBeanCreator<T*>+mutex", numThreads, options.calls,
+				timeUses(numThreads, options.calls, [&]() {
+					RandomBean* bean = manager.getBean<RandomBean*>("contention.shared");
+					std::lock_guard<std::mutex> lock(sharedLock);
+					return bean->next();
+				}));
+		addContentionResult(report, "ThreadLocalBeanCreator<T*>", numThreads, options.calls,
+				timeUses(numThreads, options.calls, [&]() {
+					return manager.getBean<RandomBean*>("contention.threadLocal")->next();
+				}));
+
+		// Reference counted pointers, each retrieval of which increments (and then decrements) the count
+		addContentionResult(report, "SmartSingletonBeanCreator<T>", numThreads, options.calls,
+				timeUses(numThreads, options.calls, [&]() {
+					return manager.getBean<std::shared_ptr<CountedBean>>("contention.sharedPtr")->value;
+				}));
+		addContentionResult(report, "SmartSingletonBeanCreator<T, IntrusivePtr>", numThreads, options.calls,
+				timeUses(numThreads, options.calls, [&]() {
+					return manager.getBean<corm::IntrusivePtr<CountedBean>>("contention.intrusive")->value;
+				}));
+		// The non-atomic count cannot be shared between threads
+		if (numThreads == 1) {
+			addContentionResult(report, "SmartSingletonBeanCreator<T, IntrusivePtr> local", numThreads, options.calls,
+					timeUses(numThreads, options.calls, [&]() {
+						return manager.getBean<corm::IntrusivePtr<LocalCountedBean>>("contention.intrusiveLocal")->value;
+					}));
+		}
+	}
+	corm::BeanStatistics::setEnabled(false);
+}
+
+}
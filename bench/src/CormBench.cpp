@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BenchOptions.h"
+#include "BenchReport.h"
+#include "ContentionBench.h"
+#include "LatencyBench.h"
+#include "LifecycleBench.h"
+#include "StartupBench.h"
+#include "corm/Trace.h"
+
+namespace bench {
+
+/*
+ * Split a comma separated list.
+ *
+ * @param list const std::string& the list
+ *
+ * @return std::vector<std::string> the entries of the list
+ */
+static std::vector<std::string> split(const std::string& list) {
+	std::vector<std::string> entries;
+	std::stringstream ss(list);
+	for (std::string entry; std::getline(ss, entry, ',');) {
+		if (!entry.empty())
+			entries.push_back(entry);
+	}
+	return entries;
+}
+
+/*
+ * Parse a number.
+ *
+ * @param value const std::string& the number to parse
+ *
+ * @return std::size_t the number
+ *
+ * @throw std::invalid_argument if the value is not a number
+ */
+static std::size_t parseNumber(const std::string& value) {
+	std::size_t parsed = 0;
+	std::size_t number = std::stoul(value, &parsed);
+	if (parsed != value.size())
+		throw std::invalid_argument("Invalid number \"" + value + "\"");
+	return number;
+}
+
+/*
+ * Parse a comma separated list of numbers.
+ *
+ * @param list const std::string& the list
+ *
+ * @return std::vector<std::size_t> the numbers
+ */
+static std::vector<std::size_t> parseNumbers(const std::string& list) {
+	std::vector<std::size_t> numbers;
+	for (const std::string& entry: split(list))
+		numbers.push_back(parseNumber(entry));
+	return numbers;
+}
+
+/*
+ * Print the usage of the benchmarks.
+ */
+static void printUsage() {
+	std::cerr << "Usage: corm_bench [options]\n"
+			"  --benchmarks B[,B...]       startup, latency, contention and/or lifecycle (default all)\n"
+			"\nStartup (assembling contexts of generated configurations):\n"
+			"  --beans N[,N...]            number of beans per graph (default 1000,10000,100000)\n"
+			"  --shapes S[,S...]           chain, diamond and/or layers (default all)\n"
+			"  --beans-per-config N        beans provided by each configuration (default 4)\n"
+			"  --width N                   width of the diamonds/layers (default 8)\n"
+			"  --fan-in N                  beans required by each configuration of a layer (default 3)\n"
+			"  --threads N[,N...]          assembly threads (default 1)\n"
+			"  --order O                   forward, reverse or shuffled registration (default shuffled)\n"
+			"  --reps N                    repetitions per run, the median of which is reported (default 3)\n"
+			"  --seed N                    seed for generating and shuffling (default 42)\n"
+			"\nLatency (retrieving beans) and contention (retrieving and using a bean which cannot be shared):\n"
+			"  --latency-threads N[,N...]  threads retrieving beans at the same time (default 1,2,4,8)\n"
+			"  --calls N                   retrievals per thread (default 200000)\n"
+			"  --statistics on|off         count the bean statistics while retrieving (default off)\n"
+			"\nLifecycle (creating and tearing down contexts of smart singletons):\n"
+			"  --cycles N                  contexts to create and tear down (default 1000)\n"
+			"\n"
+			"  --trace FILE                write a Chrome trace to FILE (requires -DENABLE_TRACING=ON)\n"
+			"  --output FILE               write the JSON report to FILE (default stdout)\n";
+}
+
+/*
+ * Parse the command line.
+ *
+ * @param argc int the number of arguments
+ * @param argv char** the arguments
+ *
+ * @return BenchOptions the options
+ *
+ * @throw std::invalid_argument if an argument is invalid
+ */
+static BenchOptions parseOptions(int argc, char** argv) {
+	BenchOptions options;
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		if (arg == "--help" || arg == "-h") {
+			printUsage();
+			std::exit(0);
+		}
+		if (i + 1 >= argc)
+			throw std::invalid_argument("Missing value for \"" + arg + "\"");
+
+		const std::string value = argv[++i];
+		if (arg == "--benchmarks")
+			options.benchmarks = split(value);
+		else if (arg == "--beans")
+			options.beans = parseNumbers(value);
+		else if (arg == "--shapes")
+			options.shapes = split(value);
+		else if (arg == "--beans-per-config")
+			options.beansPerConfig = std::max<std::size_t>(1, parseNumber(value));
+		else if (arg == "--width")
+			options.width = std::max<std::size_t>(1, parseNumber(value));
+		else if (arg == "--fan-in")
+			options.fanIn = parseNumber(value);
+		else if (arg == "--threads")
+			options.threads = parseNumbers(value);
+		else if (arg == "--order")
+			options.order = value;
+		else if (arg == "--reps")
+			options.reps = std::max<std::size_t>(1, parseNumber(value));
+		else if (arg == "--seed")
+			options.seed = (unsigned int) parseNumber(value);
+		else if (arg == "--latency-threads")
+			options.latencyThreads = parseNumbers(value);
+		else if (arg == "--calls")
+			options.calls = std::max<std::size_t>(1, parseNumber(value));
+		else if (arg == "--cycles")
+			options.cycles = std::max<std::size_t>(1, parseNumber(value));
+		else if (arg == "--trace")
+			options.trace = value;
+		else if (arg == "--statistics")
+			options.statistics = value == "on";
+		else if (arg == "--output")
+			options.output = value;
+		else
+			throw std::invalid_argument("Unknown option \"" + arg + "\"");
+	}
+
+	for (const std::string& benchmark: options.benchmarks) {
+		if (benchmark != "startup" && benchmark != "latency" && benchmark != "contention"
+				&& benchmark != "lifecycle")
+			throw std::invalid_argument("Unknown benchmark \"" + benchmark + "\"");
+	}
+	if (options.order != "forward" && options.order != "reverse" && options.order != "shuffled")
+		throw std::invalid_argument("Unknown order \"" + options.order + "\"");
+	return options;
+}
+
+}
+
+int main(int argc, char** argv) {
+	try {
+		const bench::BenchOptions options = bench::parseOptions(argc, argv);
+		bench::BenchReport report;
+		if (!options.trace.empty())
+			corm::Trace::start(options.trace);
+		for (const std::string& benchmark: options.benchmarks) {
+			if (benchmark == "startup")
+				bench::runStartupBenchmark(options, report);
+			else if (benchmark == "latency")
+				bench::runLatencyBenchmark(options, report);
+			else if (benchmark == "contention")
+				bench::runContentionBenchmark(options, report);
+			else
+				bench::runLifecycleBenchmark(options, report);
+		}
+
+		if (!options.trace.empty() && !corm::Trace::stop())
+			std::cerr << "corm_bench: unable to write the trace to " << options.trace << std::endl;
+
+		if (options.output.empty()) {
+			report.write(std::cout);
+		} else {
+			std::ofstream out(options.output);
+			report.write(out);
+		}
+	} catch (const std::exception& e) {
+		std::cerr << "corm_bench: " << e.what() << std::endl;
+		bench::printUsage();
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,187 @@
+#include "LatencyBench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LatencyHistogram.h"
+#include "corm/BeanManager.h"
+
+namespace bench {
+
+/*
+ * The bean which is retrieved.
+ */
+struct LatencyBean {
+	long value = 0;
+};
+
+/*
+ * Holder of the beans when they are accessed directly, without any manager (the same as the performance tests do,
+ * through their NoConfig providers).
+ */
+struct DirectBeans {
+	LatencyBean* singleton = new LatencyBean();
+
+	~DirectBeans() {
+		delete(singleton);
+	}
+};
+
+// The number of elements of the large read-only value bean
+static const std::size_t NUM_VALUE_ELEMENTS = 4096;
+
+// The number of other beans registered alongside those which are retrieved, so that the lookup is not trivial
+static const std::size_t NUM_FILLER_BEANS = 1000;
+
+/*
+ * Make sure that the compiler considers the value used, without generating any code for it.
+ *
+ * @param ptr const void* the value
+ */
+static inline void doNotOptimize(const void* ptr) {
+	asm volatile("" : : "r"(ptr) : "memory");
+}
+
+/*
+ * Have the threads all retrieve beans at the same time, timing each retrieval.
+ *
+ * @template Retrieve callable returning the bean
+ * @template Release callable taking the retrieved bean, to clean it up (outside of the timing)
+ *
+ * @param numThreads std::size_t the number of threads to retrieve from
+ * @param calls std::size_t the number of beans each thread retrieves
+ * @param retrieve Retrieve the retrieval to time
+ * @param release Release the clean up of each retrieved bean
+ *
+ * @return LatencyHistogram the latencies of all threads
+ */
+template<typename Retrieve, typename Release>
+static LatencyHistogram timeRetrievals(std::size_t numThreads, std::size_t calls, Retrieve retrieve, Release release) {
+	LatencyHistogram total;
+	std::mutex totalLock;
+	std::atomic<std::size_t> numReady(0);
+
+	auto run = [&]() {
+		// Each thread records into its own histogram (on its own stack), so that the histograms do not contend
+		LatencyHistogram histogram;
+
+		// Start all threads at the same time
+		numReady.fetch_add(1);
+		while (numReady.load() < numThreads)
+			std::this_thread::yield();
+
+		for (std::size_t i = 0; i < calls; i++) {
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			auto bean = retrieve();
+			const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			histogram.record(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+			doNotOptimize(&bean);
+			release(bean);
+		}
+
+		std::lock_guard<std::mutex> lock(totalLock);
+		total.merge(histogram);
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 1; t < numThreads; t++)
+		threads.emplace_back(run);
+	run();
+	for (std::thread& t: threads)
+		t.join();
+	return total;
+}
+
+/*
+ * Add the latencies to the report.
+ *
+ * @param report BenchReport& the report
+ * @param creator const std::string& the creator of the bean (or direct for the baseline)
+ * @param frozen bool whether the manager was frozen
+ * @param numThreads std::size_t the number of threads
+ * @param histogram const LatencyHistogram& the latencies
+ */
+static void addLatencyResult(BenchReport& report, const std::string& creator, bool frozen, std::size_t numThreads,
+		const LatencyHistogram& histogram) {
+	report.addResult("latency")
+			.param("creator", creator)
+			.param("frozen", frozen ? "true" : "false")
+			.param("statistics", corm::BeanStatistics::isEnabled() ? "on" : "off")
+			.param("threads", numThreads)
+			.param("calls", std::size_t(histogram.getCount()))
+			.metric("p50_ns", double(histogram.getPercentile(0.5)))
+			.metric("p99_ns", double(histogram.getPercentile(0.99)))
+			.metric("p999_ns", double(histogram.getPercentile(0.999)))
+			.metric("max_ns", double(histogram.getMax()))
+			.metric("mean_ns", histogram.getMean());
+	std::cerr << "latency " << creator << (frozen ? " frozen" : "") << " threads=" << numThreads << " done" << std::endl;
+}
+
+/*
+ * Run the latencies of all creators
+ */
+void runLatencyBenchmark(const BenchOptions& options, BenchReport& report) {
+	corm::BeanStatistics::setEnabled(options.statistics);
+	for (bool frozen: {false, true}) {
+		corm::BeanManager manager;
+		for (std::size_t i = 0; i < NUM_FILLER_BEANS; i++)
+			manager.registerBean<LatencyBean*>("latency.filler" + std::to_string(i));
+
+		LatencyBean instance;
+		manager.registerBean<LatencyBean*>("latency.singletonPointer");
+		manager.registerBean<LatencyBean&>("latency.singletonReference");
+		manager.registerBean<LatencyBean*, corm::FactoryBeanCreator<LatencyBean*>>("latency.factoryPointer");
+		manager.registerBean<std::shared_ptr<LatencyBean>, corm::SmartSingletonBeanCreator<LatencyBean>>("latency.smartSingleton");
+		manager.registerBeanInstance<LatencyBean*>("latency.instance", &instance);
+		manager.registerBean<LatencyBean*, corm::ThreadLocalBeanCreator<LatencyBean*>>("latency.threadLocal");
+		manager.registerBean<corm::PooledBean<LatencyBean>, corm::PooledBeanCreator<LatencyBean>>("latency.pooled");
+		manager.registerBeanInstance<std::vector<long>>("latency.value", std::vector<long>(NUM_VALUE_ELEMENTS, 1));
+		if (frozen)
+			manager.freeze();
+
+		// Create the singletons up front, so that only the retrieval is timed
+		manager.getBean<LatencyBean*>("latency.singletonPointer");
+		manager.getBean<LatencyBean&>("latency.singletonReference");
+		manager.getBean<std::shared_ptr<LatencyBean>>("latency.smartSingleton");
+
+		DirectBeans direct;
+		doNotOptimize(&direct);
+		auto noRelease = [](const auto&) {};
+		for (std::size_t numThreads: options.latencyThreads) {
+			numThreads = std::max<std::size_t>(1, numThreads);
+			addLatencyResult(report, "direct", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return direct.singleton; }, noRelease));
+			addLatencyResult(report, "SingletonBeanCreator<T*>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<LatencyBean*>("latency.singletonPointer"); }, noRelease));
+			addLatencyResult(report, "SingletonBeanCreator<T&>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return &manager.getBean<LatencyBean&>("latency.singletonReference"); }, noRelease));
+			addLatencyResult(report, "FactoryBeanCreator<T*>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<LatencyBean*>("latency.factoryPointer"); },
+					[](LatencyBean* bean) { delete(bean); }));
+			addLatencyResult(report, "SmartSingletonBeanCreator<T>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<std::shared_ptr<LatencyBean>>("latency.smartSingleton"); }, noRelease));
+			addLatencyResult(report, "BeanInstanceProvider<T*>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<LatencyBean*>("latency.instance"); }, noRelease));
+			addLatencyResult(report, "ThreadLocalBeanCreator<T*>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<LatencyBean*>("latency.threadLocal"); }, noRelease));
+			addLatencyResult(report, "PooledBeanCreator<T>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<corm::PooledBean<LatencyBean>>("latency.pooled"); },
+					[](corm::PooledBean<LatencyBean>& bean) { bean.release(); }));
+			// A large read-only value, copied with each retrieval or else referred to
+			addLatencyResult(report, "BeanInstanceProvider<std::vector>", frozen, numThreads, timeRetrievals(numThreads, options.calls,
+					[&]() { return manager.getBean<std::vector<long>>("latency.value"); }, noRelease));
+			addLatencyResult(report, "BeanInstanceProvider<std::vector> const T&", frozen, numThreads, timeRetrievals(numThreads,
+					options.calls, [&]() { return &manager.getBean<const std::vector<long>&>("latency.value"); }, noRelease));
+		}
+	}
+	corm::BeanStatistics::setEnabled(false);
+}
+
+}
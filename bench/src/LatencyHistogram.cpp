@@ -0,0 +1,72 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bench {
+
+// CTOR, with enough buckets for any 64 bit value
+LatencyHistogram::LatencyHistogram(): m_counts((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS, 0) {
+}
+
+/*
+ * Add the other counts to these
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+	for (std::size_t i = 0; i < m_counts.size(); i++)
+		m_counts[i] += other.m_counts[i];
+	m_count += other.m_count;
+	m_sum += other.m_sum;
+	if (other.m_max > m_max)
+		m_max = other.m_max;
+}
+
+/*
+ * Walk the buckets until the rank of the percentile is reached
+ */
+std::uint64_t LatencyHistogram::getPercentile(double fraction) const {
+	if (m_count == 0)
+		return 0;
+
+	const std::uint64_t rank = std::max<std::uint64_t>(1, std::uint64_t(std::ceil(fraction * double(m_count))));
+	std::uint64_t seen = 0;
+	for (std::size_t i = 0; i < m_counts.size(); i++) {
+		seen += m_counts[i];
+		if (seen >= rank)
+			return bucketValue(i);
+	}
+	return m_max;
+}
+
+/*
+ * Get the count
+ */
+std::uint64_t LatencyHistogram::getCount() const {
+	return m_count;
+}
+
+/*
+ * Get the mean
+ */
+double LatencyHistogram::getMean() const {
+	return m_count == 0 ? 0 : double(m_sum) / double(m_count);
+}
+
+/*
+ * Get the max
+ */
+std::uint64_t LatencyHistogram::getMax() const {
+	return m_max;
+}
+
+/*
+ * Reverse of bucketIndex
+ */
+std::uint64_t LatencyHistogram::bucketValue(std::size_t index) {
+	if (index < 2 * SUB_BUCKETS)
+		return index;
+	const std::uint64_t shift = index / SUB_BUCKETS - 1;
+	return (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+}
+
+}
@@ -0,0 +1,134 @@
+#include "LifecycleBench.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "MemoryTracker.h"
+#include "corm/Context.h"
+
+namespace bench {
+
+// The number of beans in each context
+static const std::size_t NUM_LIFECYCLE_BEANS = 64;
+
+/*
+ * The bean which is used, large enough that an instance which is never released shows.
+ */
+struct LifecycleBean {
+	char payload[4096] = {};
+};
+
+/*
+ * Smart singleton which is shared by the entire process, and so never released.
+ */
+struct ProcessSmartSingletonBeanCreator {
+	std::shared_ptr<LifecycleBean> create() {
+		static std::shared_ptr<LifecycleBean> instance(new LifecycleBean());
+		return instance;
+	}
+};
+
+/*
+ * Smart singleton per creator (just like the SmartSingletonBeanCreator), which constructs the instance separately
+ * from its reference count.
+ */
+struct SeparateSmartSingletonBeanCreator {
+	std::shared_ptr<LifecycleBean> create() {
+		if (m_guard.get() == NULL) {
+			m_guard.construct([this]() {
+				m_instance.reset(new LifecycleBean());
+				return m_instance.get();
+			});
+		}
+		return m_instance;
+	}
+
+private:
+	std::shared_ptr<LifecycleBean> m_instance;
+	corm::SingletonGuard<LifecycleBean> m_guard;
+};
+
+/*
+ * Create a context with the beans, retrieve each of them and tear the context down again.
+ *
+ * @template Creator the creator of the beans
+ *
+ * @param names const std::vector<std::string>& the names of the beans
+ */
+template<typename Creator>
+static void runLifecycle(const std::vector<std::string>& names) {
+	corm::Context context;
+	for (const std::string& name: names)
+		context.registerBean<std::shared_ptr<LifecycleBean>, Creator>(name);
+	for (const std::string& name: names)
+		context.getBean<std::shared_ptr<LifecycleBean>>(name);
+}
+
+/*
+ * Run the lifecycles of the contexts with the given creator, and add the results to the report.
+ *
+ * @template Creator the creator of the beans
+ *
+ * @param report BenchReport& the report
+ * @param creator const std::string& the name of the creator
+ * @param names const std::vector<std::string>& the names of the beans
+ * @param cycles std::size_t the number of contexts to create and tear down
+ */
+template<typename Creator>
+static void runLifecycles(BenchReport& report, const std::string& creator, const std::vector<std::string>& names,
+		std::size_t cycles) {
+	// Warm up (the heap in particular), so that anything which is only ever allocated once is not measured (other than
+	// a process wide singleton)
+	const MemoryStats initial = getMemoryStats();
+	for (std::size_t c = 0; c < cycles / 10 + 1; c++)
+		runLifecycle<Creator>(names);
+
+	resetMemoryStats();
+	const MemoryStats baseline = getMemoryStats();
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (std::size_t c = 0; c < cycles; c++)
+		runLifecycle<Creator>(names);
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const MemoryStats end = getMemoryStats();
+
+	report.addResult("lifecycle")
+			.param("creator", creator)
+			.param("beans", names.size())
+			.param("cycles", cycles)
+			.metric("us_per_cycle", seconds * 1e6 / double(cycles))
+			.metric("allocations_per_cycle", double(end.numAllocations) / double(cycles))
+			.metric("peak_bytes", double(end.peakBytes - baseline.currentBytes))
+			.metric("retained_bytes", double(end.currentBytes) - double(initial.currentBytes));
+	std::cerr << "lifecycle " << creator << " done" << std::endl;
+}
+
+/*
+ * Run the lifecycles with each of the creators
+ */
+void runLifecycleBenchmark(const BenchOptions& options, BenchReport& report) {
+	std::vector<std::string> names;
+	for (std::size_t i = 0; i < NUM_LIFECYCLE_BEANS; i++)
+		names.push_back("lifecycle.bean" + std::to_string(i));
+
+#ifdef __GLIBC__
+	// Keep the memory which is freed when a context is torn down, rather than returning it to the system (and faulting
+	// it back in) with every cycle, which would otherwise dominate the times
+	mallopt(M_TRIM_THRESHOLD, 64 * 1024 * 1024);
+#endif
+	runLifecycles<corm::SmartSingletonBeanCreator<LifecycleBean>>(report, "SmartSingletonBeanCreator<T>", names,
+			options.cycles);
+	runLifecycles<SeparateSmartSingletonBeanCreator>(report, "per creator, separate allocation", names, options.cycles);
+	runLifecycles<ProcessSmartSingletonBeanCreator>(report, "per process, never released", names, options.cycles);
+#ifdef __GLIBC__
+	mallopt(M_TRIM_THRESHOLD, 128 * 1024);
+#endif
+}
+
+}
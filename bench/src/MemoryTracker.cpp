@@ -0,0 +1,132 @@
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+// The tracked heap usage
+static std::atomic<std::size_t> currentBytes(0);
+static std::atomic<std::size_t> peakBytes(0);
+static std::atomic<std::size_t> numAllocations(0);
+
+/*
+ * Reset the peak and the allocations
+ */
+void resetMemoryStats() {
+	peakBytes.store(currentBytes.load());
+	numAllocations.store(0);
+}
+
+/*
+ * Get the usage
+ */
+MemoryStats getMemoryStats() {
+	return MemoryStats{currentBytes.load(), peakBytes.load(), numAllocations.load()};
+}
+
+/*
+ * Track an allocation of the specified size.
+ *
+ * @param size std::size_t the number of bytes allocated
+ */
+static void trackAllocation(std::size_t size) {
+	numAllocations.fetch_add(1, std::memory_order_relaxed);
+	std::size_t current = currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	std::size_t peak = peakBytes.load(std::memory_order_relaxed);
+	while (current > peak && !peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+		;
+}
+
+/*
+ * Allocate the memory, with a header in front of it recording the size of the allocation. The header is as large
+ * as the alignment, so that the memory handed out remains aligned.
+ *
+ * @param size std::size_t the number of bytes to allocate
+ * @param alignment std::size_t the alignment of the memory (power of two, at least that of std::max_align_t)
+ *
+ * @return void* pointer to the allocated memory, or NULL if none is available
+ */
+static void* allocate(std::size_t size, std::size_t alignment) {
+	std::size_t total = (size + 2 * alignment - 1) / alignment * alignment;
+	char* base = static_cast<char*>(std::aligned_alloc(alignment, total));
+	if (base == NULL)
+		return NULL;
+
+	char* ptr = base + alignment;
+	reinterpret_cast<std::size_t*>(ptr)[-1] = size;
+	reinterpret_cast<std::size_t*>(ptr)[-2] = alignment;
+	trackAllocation(size);
+	return ptr;
+}
+
+/*
+ * Free the memory allocated through allocate.
+ *
+ * @param ptr void* pointer to the memory (can be NULL)
+ */
+static void deallocate(void* ptr) {
+	if (ptr == NULL)
+		return;
+
+	std::size_t size = static_cast<std::size_t*>(ptr)[-1];
+	std::size_t alignment = static_cast<std::size_t*>(ptr)[-2];
+	currentBytes.fetch_sub(size, std::memory_order_relaxed);
+	std::free(static_cast<char*>(ptr) - alignment);
+}
+
+}
+
+void* operator new(std::size_t size) {
+	if (void* ptr = bench::allocate(size, alignof(std::max_align_t)))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	if (void* ptr = bench::allocate(size, std::max(std::size_t(alignment), alignof(std::max_align_t))))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+	bench::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+	bench::deallocate(ptr);
+}
@@ -0,0 +1,161 @@
+#include "StartupBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MemoryTracker.h"
+#include "SyntheticGraph.h"
+
+namespace bench {
+
+/*
+ * The measurements of a single repetition of a run.
+ */
+struct StartupSample {
+	double registerMs;
+	double assembleMs;
+	double freezeMs;
+	double firstAccessMs;
+	double teardownMs;
+	double peakBytes;
+	double numAllocations;
+};
+
+/*
+ * Generate the graph of the given shape.
+ *
+ * @param shape const std::string& the shape of the graph
+ * @param numBeans std::size_t the number of beans
+ * @param options const BenchOptions& the options
+ *
+ * @return SyntheticGraph the graph
+ *
+ * @throw std::invalid_argument if the shape is unknown
+ */
+static SyntheticGraph generateGraph(const std::string& shape, std::size_t numBeans, const BenchOptions& options) {
+	if (shape == "chain")
+		return generateChain(numBeans, options.beansPerConfig);
+	if (shape == "diamond")
+		return generateDiamonds(numBeans, options.beansPerConfig, options.width);
+	if (shape == "layers")
+		return generateLayers(numBeans, options.beansPerConfig, options.width, options.fanIn, options.seed);
+	throw std::invalid_argument("Unknown shape \"" + shape + "\"");
+}
+
+/*
+ * Time how long the function takes.
+ *
+ * @param f const std::function<void()>& the function to time
+ *
+ * @return double the time in milliseconds
+ */
+static double timeMs(const std::function<void()>& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * Run the full lifecycle of a context for the graph once: registering the configurations, assembling the context,
+ * freezing it, retrieving every bean once (creating it), and destroying the context.
+ *
+ * @param graph const SyntheticGraph& the graph to build the context for
+ * @param order const std::vector<std::size_t>& the order in which to register the configurations
+ * @param numThreads std::size_t the number of threads to assemble with
+ *
+ * @return StartupSample the measurements
+ */
+static StartupSample runStartup(const SyntheticGraph& graph, const std::vector<std::size_t>& order, std::size_t numThreads) {
+	StartupSample sample;
+	resetMemoryStats();
+	const MemoryStats baseline = getMemoryStats();
+
+	corm::Context* context = new corm::Context();
+	sample.registerMs = timeMs([&]() {
+		for (std::size_t c: order)
+			context->registerConfiguration(new SyntheticConfigurationWrapper(context, graph.configs[c]));
+	});
+	sample.assembleMs = timeMs([&]() { context->assemble((unsigned int) numThreads); });
+	sample.freezeMs = timeMs([&]() { context->freeze(); });
+	sample.firstAccessMs = timeMs([&]() {
+		for (const SyntheticConfigSpec& c: graph.configs) {
+			for (const std::string& bean: c.beans)
+				context->getBean<SyntheticBean*>(bean);
+		}
+	});
+
+	const MemoryStats peak = getMemoryStats();
+	sample.peakBytes = double(peak.peakBytes - baseline.currentBytes);
+	sample.numAllocations = double(peak.numAllocations);
+
+	sample.teardownMs = timeMs([&]() { delete(context); });
+	return sample;
+}
+
+/*
+ * Get the median of one measurement across all samples.
+ *
+ * @param samples const std::vector<StartupSample>& the samples
+ * @param field double StartupSample::* the measurement
+ *
+ * @return double the median
+ */
+static double median(const std::vector<StartupSample>& samples, double StartupSample::* field) {
+	std::vector<double> values;
+	for (const StartupSample& s: samples)
+		values.push_back(s.*field);
+	std::sort(values.begin(), values.end());
+	const std::size_t mid = values.size() / 2;
+	return values.size() % 2 == 1 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+/*
+ * Run every combination of the options
+ */
+void runStartupBenchmark(const BenchOptions& options, BenchReport& report) {
+	for (const std::string& shape: options.shapes) {
+		for (std::size_t numBeans: options.beans) {
+			const SyntheticGraph graph = generateGraph(shape, numBeans, options);
+
+			std::vector<std::size_t> order(graph.configs.size());
+			for (std::size_t c = 0; c < order.size(); c++)
+				order[c] = c;
+			if (options.order == "reverse")
+				std::reverse(order.begin(), order.end());
+			else if (options.order == "shuffled")
+				std::shuffle(order.begin(), order.end(), std::mt19937(options.seed));
+
+			for (std::size_t numThreads: options.threads) {
+				std::vector<StartupSample> samples;
+				for (std::size_t r = 0; r < options.reps; r++)
+					samples.push_back(runStartup(graph, order, numThreads));
+
+				report.addResult("startup")
+						.param("shape", shape)
+						.param("beans", graph.getNumBeans())
+						.param("configs", graph.configs.size())
+						.param("dependencies", graph.getNumDependencies())
+						.param("order", options.order)
+						.param("threads", numThreads)
+						.param("reps", options.reps)
+						.metric("register_ms", median(samples, &StartupSample::registerMs))
+						.metric("assemble_ms", median(samples, &StartupSample::assembleMs))
+						.metric("freeze_ms", median(samples, &StartupSample::freezeMs))
+						.metric("first_access_ms", median(samples, &StartupSample::firstAccessMs))
+						.metric("teardown_ms", median(samples, &StartupSample::teardownMs))
+						.metric("peak_bytes", median(samples, &StartupSample::peakBytes))
+						.metric("allocations", median(samples, &StartupSample::numAllocations));
+				std::cerr << "startup " << shape << " beans=" << graph.getNumBeans() << " threads=" << numThreads
+						<< " done" << std::endl;
+			}
+		}
+	}
+}
+
+}
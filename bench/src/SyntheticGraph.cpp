@@ -0,0 +1,192 @@
+#include "SyntheticGraph.h"
+
+#include <algorithm>
+#include <random>
+
+namespace bench {
+
+/*
+ * Count the beans
+ */
+std::size_t SyntheticGraph::getNumBeans() const {
+	std::size_t numBeans = 0;
+	for (const SyntheticConfigSpec& c: configs)
+		numBeans += c.beans.size();
+	return numBeans;
+}
+
+/*
+ * Count the dependencies
+ */
+std::size_t SyntheticGraph::getNumDependencies() const {
+	std::size_t numDependencies = 0;
+	for (const SyntheticConfigSpec& c: configs)
+		numDependencies += c.resources.size();
+	return numDependencies;
+}
+
+/*
+ * Add a configuration to the graph, which provides the specified number of beans.
+ *
+ * @param graph SyntheticGraph& the graph to add the configuration to
+ * @param beansPerConfig std::size_t the number of beans that the configuration provides
+ *
+ * @return SyntheticConfigSpec& the added configuration
+ */
+static SyntheticConfigSpec& addConfig(SyntheticGraph& graph, std::size_t beansPerConfig) {
+	const std::string name = graph.shape + "Config" + std::to_string(graph.configs.size());
+	graph.configs.push_back(SyntheticConfigSpec{name, {}, {}});
+	SyntheticConfigSpec& config = graph.configs.back();
+	for (std::size_t b = 0; b < beansPerConfig; b++)
+		config.beans.push_back(name + ".bean" + std::to_string(b));
+	return config;
+}
+
+/*
+ * Get the number of configurations needed for the beans
+ *
+ * @param numBeans std::size_t the number of beans
+ * @param beansPerConfig std::size_t the number of beans per configuration
+ *
+ * @return std::size_t the number of configurations (at least 1)
+ */
+static std::size_t getNumConfigs(std::size_t numBeans, std::size_t beansPerConfig) {
+	return std::max<std::size_t>(1, numBeans / std::max<std::size_t>(1, beansPerConfig));
+}
+
+/*
+ * Generate the chain
+ */
+SyntheticGraph generateChain(std::size_t numBeans, std::size_t beansPerConfig) {
+	SyntheticGraph graph{"chain", {}};
+	const std::size_t numConfigs = getNumConfigs(numBeans, beansPerConfig);
+	graph.configs.reserve(numConfigs);
+	for (std::size_t c = 0; c < numConfigs; c++) {
+		SyntheticConfigSpec& config = addConfig(graph, beansPerConfig);
+		if (c > 0)
+			config.resources.push_back(graph.configs[c - 1].beans.front());
+	}
+	return graph;
+}
+
+/*
+ * Generate the diamonds
+ */
+SyntheticGraph generateDiamonds(std::size_t numBeans, std::size_t beansPerConfig, std::size_t width) {
+	SyntheticGraph graph{"diamond", {}};
+	const std::size_t numConfigs = getNumConfigs(numBeans, beansPerConfig);
+	graph.configs.reserve(numConfigs + width + 2);
+	while (graph.configs.size() < numConfigs) {
+		// The top of the diamond depends on the bottom of the previous diamond
+		const std::string previous = graph.configs.empty() ? "" : graph.configs.back().beans.front();
+		SyntheticConfigSpec& top = addConfig(graph, beansPerConfig);
+		if (!previous.empty())
+			top.resources.push_back(previous);
+		const std::string topBean = top.beans.front();
+
+		std::vector<std::string> middleBeans;
+		for (std::size_t w = 0; w < width; w++) {
+			SyntheticConfigSpec& middle = addConfig(graph, beansPerConfig);
+			middle.resources.push_back(topBean);
+			middleBeans.push_back(middle.beans.front());
+		}
+
+		SyntheticConfigSpec& bottom = addConfig(graph, beansPerConfig);
+		bottom.resources = middleBeans;
+	}
+	return graph;
+}
+
+/*
+ * Generate the layers
+ */
+SyntheticGraph generateLayers(std::size_t numBeans, std::size_t beansPerConfig, std::size_t width, std::size_t fanIn,
+		unsigned int seed) {
+	SyntheticGraph graph{"layers", {}};
+	const std::size_t numConfigs = getNumConfigs(numBeans, beansPerConfig);
+	graph.configs.reserve(numConfigs);
+	std::mt19937 random(seed);
+	for (std::size_t c = 0; c < numConfigs; c++) {
+		SyntheticConfigSpec& config = addConfig(graph, beansPerConfig);
+
+		// Pick the beans from the previous layer, without repeating any
+		const std::size_t layerStart = c - c % width;
+		if (layerStart == 0)
+			continue;
+		std::vector<std::string> candidates;
+		for (std::size_t p = layerStart - width; p < layerStart; p++)
+			candidates.insert(candidates.end(), graph.configs[p].beans.begin(), graph.configs[p].beans.end());
+		std::shuffle(candidates.begin(), candidates.end(), random);
+		candidates.resize(std::min(fanIn, candidates.size()));
+		config.resources = candidates;
+	}
+	return graph;
+}
+
+// CTOR
+SyntheticConfiguration::SyntheticConfiguration(corm::BeanManager* manager, const SyntheticConfigSpec& spec):
+		BaseConfiguration(manager), m_spec(spec) {
+}
+
+/*
+ * Resolve all resources
+ */
+void SyntheticConfiguration::postInit() {
+	m_resources.reserve(m_spec.resources.size());
+	for (const std::string& resource: m_spec.resources)
+		m_resources.push_back(m_beanManager->getBeanRef<SyntheticBean*>(resource));
+}
+
+/*
+ * Register all beans
+ */
+void SyntheticConfiguration::provideBeans() {
+	for (const std::string& bean: m_spec.beans)
+		m_beanManager->registerBean<SyntheticBean*>(bean);
+}
+
+// CTOR
+SyntheticConfigurationWrapper::SyntheticConfigurationWrapper(corm::BeanManager* manager, const SyntheticConfigSpec& spec):
+		m_beanManager(manager), m_spec(spec), m_waitingResources(spec.resources) {
+}
+
+/*
+ * Get the name of the configuration
+ */
+std::string SyntheticConfigurationWrapper::getName() const {
+	return m_spec.name;
+}
+
+/*
+ * Check the resources
+ */
+bool SyntheticConfigurationWrapper::areResourcesSatisfied() {
+	m_waitingResources.erase(std::remove_if(m_waitingResources.begin(), m_waitingResources.end(),
+			[this](const std::string& s) { return m_beanManager->containsBean(s); }), m_waitingResources.end());
+	return m_waitingResources.empty();
+}
+
+/*
+ * Build the configuration
+ */
+corm::BaseConfiguration* SyntheticConfigurationWrapper::buildConfig() {
+	if (!areResourcesSatisfied())
+		throw corm::ConfigurationMissingResourcesException(getName(), m_waitingResources);
+	return new SyntheticConfiguration(m_beanManager, m_spec);
+}
+
+/*
+ * Get the waiting resources
+ */
+const std::vector<std::string>& SyntheticConfigurationWrapper::getWaitingResources() const {
+	return m_waitingResources;
+}
+
+/*
+ * Get the beans
+ */
+const std::vector<std::string>& SyntheticConfigurationWrapper::getBeanNames() const {
+	return m_spec.beans;
+}
+
+}
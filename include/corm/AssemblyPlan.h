@@ -0,0 +1,99 @@
+#ifndef ASSEMBLYPLAN_H_
+#define ASSEMBLYPLAN_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace corm {
+
+class ConfigurationWrapperInterface;
+
+/*
+ * The resolved plan of an assembly: the order in which the configurations were loaded. The plan is tied to the
+ * configurations that it was made for through a fingerprint of their names, resources and beans (in the order in
+ * which they were registered), so that a plan is only ever followed for the very same set of configurations. The
+ * plan is only a hint as to the order, as each configuration still verifies its own resources when it is loaded.
+ *
+ * The plan can be persisted to a compact binary file, laid out as (all integers in the native byte order):
+ *        * the magic "CORMPLAN" (8 bytes), followed by the version of the format (uint32)
+ *        * the fingerprint (uint64)
+ *        * the number of configurations in the load order (uint32), followed by the index of each (uint32), being
+ *          the position in which the configuration was registered
+ */
+class AssemblyPlan {
+
+public:
+	// CTOR of an empty plan, which matches no configurations
+	AssemblyPlan() = default;
+
+	/*
+	 * CTOR
+	 *
+	 * @param fingerprint std::uint64_t the fingerprint of the configurations that the plan is for
+	 * @param loadOrder std::vector<std::uint32_t> the index of each configuration, in the order in which to load them
+	 */
+	AssemblyPlan(std::uint64_t fingerprint, std::vector<std::uint32_t> loadOrder);
+
+	/*
+	 * Compute the fingerprint of the configurations.
+	 *
+	 * @param configs const std::vector<ConfigurationWrapperInterface*>& the configurations, in the order in which they
+	 *        were registered
+	 *
+	 * @return std::uint64_t the fingerprint, which is the same across runs (and builds) for the same configurations
+	 */
+	static std::uint64_t fingerprint(const std::vector<ConfigurationWrapperInterface*>& configs);
+
+	/*
+	 * Write the plan to a file.
+	 *
+	 * @param path const std::string& the file to write
+	 *
+	 * @return bool true if the file was written
+	 */
+	bool write(const std::string& path) const;
+
+	/*
+	 * Read a plan from a file.
+	 *
+	 * @param path const std::string& the file to read
+	 *
+	 * @return bool true if the plan was read, false if the file cannot be read, or is not a plan of the current
+	 *         version (in which case the plan is left empty)
+	 */
+	bool read(const std::string& path);
+
+	/*
+	 * Check whether the plan is empty (in which case it matches no configurations).
+	 *
+	 * @return bool true if empty
+	 */
+	bool isEmpty() const;
+
+	/*
+	 * Get the fingerprint of the configurations that the plan is for.
+	 *
+	 * @return std::uint64_t the fingerprint
+	 */
+	std::uint64_t getFingerprint() const;
+
+	/*
+	 * Get the order in which to load the configurations.
+	 *
+	 * @return const std::vector<std::uint32_t>& the index of each configuration (in order of registration)
+	 */
+	const std::vector<std::uint32_t>& getLoadOrder() const;
+
+private:
+	// Whether the plan was made (or read)
+	bool m_valid = false;
+	// The fingerprint of the configurations
+	std::uint64_t m_fingerprint = 0;
+	// The index of each configuration, in the order in which to load them
+	std::vector<std::uint32_t> m_loadOrder;
+};
+
+}
+
+#endif /* ASSEMBLYPLAN_H_ */
@@ -1,28 +1,56 @@
 #ifndef BEANCREATOR_H_
 #define BEANCREATOR_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include "BeanPool.h"
+#include "BeanScope.h"
+#include "IntrusivePtr.h"
+#include "ThreadLocalBeans.h"
 
 namespace corm {
 
 /*
- * Simple wrapper struct, which allow passing the created type from the BeanCreator
- * to the BeanProvider without the bean provider being dependent on what type of
- * value the creator is creating.
+ * Creators are responsible for creating (or otherwise managing) the instances of a bean. A creator for a bean of
+ * type T must provide a method matching the signature of T create(), which returns the bean directly (by value for
+ * scalars and pointers, or by reference for references) so that no interim storage is required when a bean is
+ * retrieved.
+ *
+ * By default every call to create is taken to create a new bean (see BeanStatistics). A creator which instead reuses
+ * its instances (a singleton, or one instance per scope, per thread, ...) declares so through
+ *
+ * 		static constexpr bool reusesInstance = true;
  *
- * This will wrap the value (whatever type it is) in a pointer, that can then easily
- * be passed around.
+ * in which case it must also provide template<class Observer> T create(Observer observe). That create passes each
+ * instance which it actually constructs through the observer, as observe(construct), where construct is a callable
+ * performing the construction (returning whatever the creator needs, such as a pointer to the instance) and the
+ * observer returns the outcome of construct. Only the constructions passed through the observer count as creations.
+ * Note that a subclass which overrides T create() of such a creator must override the observed create as well.
  */
-template<typename T>
-struct ValueWrapper {
-
-	T m_value;
 
-	ValueWrapper(T val) :
-			m_value(val) {
+/*
+ * Observer of the instances constructed by a creator which reuses its instances, which simply constructs them.
+ */
+struct DirectConstruction {
+	template<typename Construct>
+	decltype(auto) operator()(Construct construct) const {
+		return construct();
 	}
 };
 
+/*
+ * Indicates whether the creator reuses its instances (see above), rather than creating a new bean with each call.
+ */
+template<class Creator, typename = void>
+struct ReusesInstance: std::false_type {};
+
+template<class Creator>
+struct ReusesInstance<Creator, std::void_t<decltype(Creator::reusesInstance)>>: std::bool_constant<Creator::reusesInstance> {};
+
 /*
  * Singleton creator for a scalar.
  *
@@ -34,8 +62,16 @@ struct ValueWrapper {
 template<typename T>
 struct SingletonBeanCreator {
 #ifdef ENABLE_BEAN_AUTOREGISTRATION
-	ValueWrapper<T>* create() {
-		return new ValueWrapper<T>(m_instance);
+	static constexpr bool reusesInstance = true;
+
+	T create() {
+		return m_instance;
+	}
+
+	// The instance is constructed along with the creator, so there is nothing to observe
+	template<class Observer>
+	T create(Observer) {
+		return m_instance;
 	}
 
 private:
@@ -48,9 +84,16 @@ private:
  */
 template<typename T>
 struct SingletonBeanCreator<T&> {
+	static constexpr bool reusesInstance = true;
 
-	ValueWrapper<T&>* create() {
-		return new ValueWrapper<T&>(m_instance);
+	T& create() {
+		return m_instance;
+	}
+
+	// The instance is constructed along with the creator, so there is nothing to observe
+	template<class Observer>
+	T& create(Observer) {
+		return m_instance;
 	}
 
 private:
@@ -59,26 +102,105 @@ private:
 };
 
 /*
- * Singleton creator for pointers
+ * Publishes an instance which is constructed lazily, exactly once even when first requested from several threads at
+ * the same time: once the instance exists, get is a single (acquire) load, while until then the threads requesting it
+ * wait for the one which is constructing it. No lock is held during the construction itself, so that constructing one
+ * singleton can request another. Should the construction throw, the next request tries again.
+ *
+ * The guard only publishes the instance, the owner is responsible for destroying it.
+ *
+ * @template T the type of the instance
+ */
+template<typename T>
+class SingletonGuard {
+
+public:
+	/*
+	 * Get the instance, if it has been constructed.
+	 *
+	 * @return T* the instance, or NULL if not (yet) constructed
+	 */
+	T* get() const {
+		return m_instance.load(std::memory_order_acquire);
+	}
+
+	/*
+	 * Construct the instance, unless another thread did so (or is doing so) already.
+	 *
+	 * @template Construct callable which constructs the instance, returning a pointer to it
+	 *
+	 * @param construct Construct the construction
+	 *
+	 * @return T* the instance
+	 */
+	template<typename Construct>
+	T* construct(Construct construct) {
+		std::unique_lock<std::mutex> lock(m_constructionLock);
+		m_constructionDone.wait(lock, [this]() { return !m_constructing; });
+		if (T* instance = m_instance.load(std::memory_order_relaxed))
+			return instance;
+		m_constructing = true;
+		lock.unlock();
+
+		T* instance = NULL;
+		try {
+			instance = construct();
+		} catch (...) {
+			finishConstruction(NULL);
+			throw;
+		}
+		finishConstruction(instance);
+		return instance;
+	}
+
+private:
+	// The instance, only set once fully constructed
+	std::atomic<T*> m_instance = NULL;
+	// Guards whether the instance is being constructed
+	std::mutex m_constructionLock;
+	// Notified once the construction has completed (or failed)
+	std::condition_variable m_constructionDone;
+	// Whether a thread is constructing the instance
+	bool m_constructing = false;
+
+	/*
+	 * Publish the outcome of the construction, and wake any thread waiting on it.
+	 *
+	 * @param instance T* the constructed instance (NULL if the construction failed)
+	 */
+	void finishConstruction(T* instance) {
+		std::lock_guard<std::mutex> lock(m_constructionLock);
+		m_instance.store(instance, std::memory_order_release);
+		m_constructing = false;
+		m_constructionDone.notify_all();
+	}
+};
+
+/*
+ * Singleton creator for pointers. The instance is created lazily, exactly once (see SingletonGuard).
  */
 template<typename T>
 struct SingletonBeanCreator<T*> {
 	virtual ~SingletonBeanCreator() {
-		if (m_instance != NULL)
-			delete(m_instance);
+		delete(m_guard.get());
 	}
 
-	virtual ValueWrapper<T*>* create() {
-		// Delay creation until it is actually needed
-		if (m_instance == NULL)
-			m_instance = new T();
+	static constexpr bool reusesInstance = true;
+
+	virtual T* create() {
+		return create(DirectConstruction());
+	}
 
-		return new ValueWrapper<T*>(m_instance);
+	template<class Observer>
+	T* create(Observer observe) {
+		T* instance = m_guard.get();
+		// Delay creation until it is actually needed
+		return instance != NULL ? instance : m_guard.construct([&observe]() { return observe([]() { return new T(); }); });
 	}
 
 private:
-	// The managed singleton instance
-	T *m_instance = NULL;
+	// Publishes the managed singleton instance
+	SingletonGuard<T> m_guard;
 };
 
 /*
@@ -87,8 +209,8 @@ private:
  */
 template<class T>
 struct FactoryBeanCreator {
-	ValueWrapper<T>* create() {
-		return new ValueWrapper<T>(T());
+	T create() {
+		return T();
 	}
 };
 
@@ -106,20 +228,66 @@ struct FactoryBeanCreator<T&> {
  */
 template<typename T>
 struct FactoryBeanCreator<T*> {
-	ValueWrapper<T*>* create() {
-		return new ValueWrapper<T*>(new T());
+	T* create() {
+		return new T();
+	}
+};
+
+/*
+ * Creates a new instance wrapped in a smart pointer of type Ptr. By default the instance is constructed separately
+ * and then handed to the smart pointer.
+ */
+template<template <typename> class Ptr>
+struct SmartPointerFactory {
+	template<typename T>
+	static Ptr<T> make() {
+		return Ptr<T>(new T());
+	}
+};
+
+/*
+ * A std::shared_ptr is made with a single allocation, holding both the instance and its reference count.
+ */
+template<>
+struct SmartPointerFactory<std::shared_ptr> {
+	template<typename T>
+	static std::shared_ptr<T> make() {
+		return std::make_shared<T>();
 	}
 };
 
 /*
- * Singleton creator which wraps the singleton instance in a smart pointer. Defaults to a std::shared_ptr.
+ * Singleton creator which wraps the singleton instance in a smart pointer. Defaults to a std::shared_ptr. Each creator
+ * (and so each bean) has its own instance, which is created lazily, exactly once (see SingletonGuard), and which the
+ * creator lets go of when it is destroyed along with its context.
  */
 template<typename T, template <typename> class Ptr = std::shared_ptr>
 struct SmartSingletonBeanCreator {
-	ValueWrapper<Ptr<T>>* create() {
-		static Ptr<T> smrtPtr(new T());
-		return new ValueWrapper<Ptr<T>>(smrtPtr);
+	static_assert(std::is_copy_constructible_v<Ptr<T>>,
+			"the singleton is shared, so it cannot be held by a move-only pointer (see SmartFactoryBeanCreator)");
+
+	static constexpr bool reusesInstance = true;
+
+	Ptr<T> create() {
+		return create(DirectConstruction());
 	}
+
+	template<class Observer>
+	Ptr<T> create(Observer observe) {
+		if (m_guard.get() == NULL) {
+			m_guard.construct([this, &observe]() {
+				m_instance = observe([]() { return SmartPointerFactory<Ptr>::template make<T>(); });
+				return m_instance.get();
+			});
+		}
+		return m_instance;
+	}
+
+private:
+	// The managed singleton instance, only read once published by the guard
+	Ptr<T> m_instance;
+	// Publishes the instance
+	SingletonGuard<T> m_guard;
 };
 
 /*
@@ -128,8 +296,200 @@ struct SmartSingletonBeanCreator {
  */
 template<typename T, template <typename> class Ptr = std::shared_ptr>
 struct SmartFactoryBeanCreator {
-	ValueWrapper<Ptr<T>>* create() {
-		return new ValueWrapper<Ptr<T>>(Ptr<T>(new T()));
+	Ptr<T> create() {
+		return SmartPointerFactory<Ptr>::template make<T>();
+	}
+};
+
+/*
+ * Creator of a single instance per BeanScope, such that the bean is shared by everything within the same unit
+ * of work. The instance is created within the innermost scope which is active on the retrieving thread, and is
+ * released along with that scope.
+ *
+ * Intentionally left unimplemented for scalars, which cannot be shared.
+ */
+template<typename T>
+struct ScopedBeanCreator {
+};
+
+/*
+ * Creator of a single pointer instance per BeanScope
+ *
+ * @throws NoActiveBeanScopeException if no scope is active on the current thread
+ */
+template<typename T>
+struct ScopedBeanCreator<T*> {
+	static constexpr bool reusesInstance = true;
+
+	T* create() {
+		return create(DirectConstruction());
+	}
+
+	template<class Observer>
+	T* create(Observer observe) {
+		return BeanScope::requireCurrent().getInstance<T>(this, observe);
+	}
+};
+
+/*
+ * Creator of a single reference instance per BeanScope
+ *
+ * @throws NoActiveBeanScopeException if no scope is active on the current thread
+ */
+template<typename T>
+struct ScopedBeanCreator<T&> {
+	static constexpr bool reusesInstance = true;
+
+	T& create() {
+		return create(DirectConstruction());
+	}
+
+	template<class Observer>
+	T& create(Observer observe) {
+		return *BeanScope::requireCurrent().getInstance<T>(this, observe);
+	}
+};
+
+/*
+ * Creator where a new instance is created each time create is called, within the innermost BeanScope which is
+ * active on the retrieving thread. Unlike FactoryBeanCreator<T*>, the client code need not delete the instance,
+ * as it is released along with the scope.
+ *
+ * Intentionally left unimplemented for scalars and references, which FactoryBeanCreator already covers (or which
+ * do not make sense).
+ */
+template<typename T>
+struct ScopedFactoryBeanCreator {
+};
+
+/*
+ * Creator of a new pointer instance within the BeanScope each time create is called
+ *
+ * @throws NoActiveBeanScopeException if no scope is active on the current thread
+ */
+template<typename T>
+struct ScopedFactoryBeanCreator<T*> {
+	T* create() {
+		return BeanScope::requireCurrent().create<T>();
+	}
+};
+
+/*
+ * Creator of a single instance per thread, for beans which are cheap to duplicate but costly to share (i.e.: scratch
+ * buffers, random number generators, accumulators). Each thread retrieving the bean lazily gets its own instance, which
+ * it then retrieves without any synchronization. The instance of a thread is destroyed when the thread ends, or else
+ * along with the creator (i.e.: when the context ends).
+ *
+ * Intentionally left unimplemented for scalars, of which every retrieval is a copy anyway.
+ */
+template<typename T>
+struct ThreadLocalBeanCreator {
+};
+
+/*
+ * Creator of a single pointer instance per thread
+ */
+template<typename T>
+struct ThreadLocalBeanCreator<T*> {
+	static constexpr bool reusesInstance = true;
+
+	T* create() {
+		return create(DirectConstruction());
+	}
+
+	template<class Observer>
+	T* create(Observer observe) {
+		if (void* instance = m_instances.find())
+			return static_cast<T*>(instance);
+
+		T* instance = observe([]() { return new T(); });
+		try {
+			m_instances.insert(instance);
+		} catch (...) {
+			delete(instance);
+			throw;
+		}
+		return instance;
+	}
+
+private:
+	// The instance of each thread
+	ThreadLocalBeans m_instances{[](void* instance) { delete(static_cast<T*>(instance)); }};
+};
+
+/*
+ * Creator of a single reference instance per thread
+ */
+template<typename T>
+struct ThreadLocalBeanCreator<T&> {
+	static constexpr bool reusesInstance = true;
+
+	T& create() {
+		return *m_creator.create();
+	}
+
+	template<class Observer>
+	T& create(Observer observe) {
+		return *m_creator.create(observe);
+	}
+
+private:
+	// Manages the instance of each thread
+	ThreadLocalBeanCreator<T*> m_creator;
+};
+
+/*
+ * Reset hook of a PooledBeanCreator, which leaves the returned instances as they are.
+ */
+struct NoPoolReset {
+	template<typename T>
+	void operator()(T&) const {}
+};
+
+/*
+ * Creator which hands out instances from a bounded pool (see BeanPool), rather than constructing a new instance with
+ * every call as FactoryBeanCreator<T*> does. The bean is a PooledBean<T> handle, which returns the instance to the
+ * pool once released (or out of scope), so the bean is registered and retrieved as PooledBean<T>. The hits and misses
+ * of the pool can be retrieved through the pool of any handle (PooledBean::getPool).
+ *
+ * @template T the type of the instances
+ * @template Capacity the maximum number of free instances kept by the pool
+ * @template Reset functor which is applied to each instance when returned to the pool (i.e.: to clear a buffer)
+ */
+template<typename T, std::size_t Capacity = 64, class Reset = NoPoolReset>
+struct PooledBeanCreator {
+	static constexpr bool reusesInstance = true;
+
+	PooledBean<T> create() {
+		return m_pool.acquire();
+	}
+
+	// Only a miss constructs an instance
+	template<class Observer>
+	PooledBean<T> create(Observer observe) {
+		return m_pool.acquire(observe);
+	}
+
+	/*
+	 * Get the pool of the instances.
+	 *
+	 * @return BeanPool<T>& the pool
+	 */
+	BeanPool<T>& getPool() {
+		return m_pool;
+	}
+
+private:
+	// The pool of the instances
+	BeanPool<T> m_pool{Capacity, std::is_same<Reset, NoPoolReset>::value ? NULL : &PooledBeanCreator::reset};
+
+	/*
+	 * Apply the reset hook to the instance.
+	 *
+	 * @param bean T& the instance
+	 */
+	static void reset(T& bean) {
+		Reset()(bean);
 	}
 };
 
@@ -2,12 +2,16 @@
 #define BEANMANAGER_H_
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <algorithm>
-#include <typeinfo>
 
 #include "BeanProvider.h"
+#include "BeanRef.h"
+#include "BeanRegistry.h"
+#include "ResolutionGuard.h"
+#include "BeanStatistics.h"
 #include "exception/InvalidBeanException.h"
 
 namespace corm {
@@ -25,13 +29,41 @@ namespace corm {
  *        be created via its default constructor)
  *
  * To enable the auto-register capability, compile with the ENABLE_BEAN_AUTOREGISTRATION flag/symbol defined.
+ *
+ * The manager is thread-safe, allowing an assembled context to be shared across threads. Retrieving a bean
+ * takes no locks (see BeanRegistry), while registering a bean is serialized with other registrations only.
+ * Note that the creators are responsible for the thread-safety of the beans that they create.
+ *
+ * Once all beans are registered (i.e.: once a Context is assembled), the manager can be frozen. Freezing
+ * compiles all of the beans into a perfect hashed table (see FrozenBeanTable), which makes retrieving a bean
+ * by name cheaper, while any further registration is rejected.
+ *
+ * A manager can be created as the child of another (parent) manager, in which case any bean that is not registered
+ * with the child itself is retrieved from the parent (and so on up the chain). The beans of the parent are shared
+ * rather than copied, making a child as cheap to create and destroy as the beans that it registers itself. A child
+ * cannot register a bean under a name which is already taken by its parent, and the parent must outlive the child.
  */
 class BeanManager {
 
 public:
+	// CTOR of a manager without parent
+	BeanManager() = default;
+
+	/*
+	 * CTOR of a child manager.
+	 *
+	 * @param parent BeanManager* pointer to the manager to fall back to for the beans which are not registered with
+	 *        the child. Typically already assembled (and frozen), it must outlive the child.
+	 */
+	explicit BeanManager(BeanManager* parent);
+
 	// DTOR
 	virtual ~BeanManager();
 
+	// The manager owns its providers, and children refer to it
+	BeanManager(const BeanManager&) = delete;
+	BeanManager& operator=(const BeanManager&) = delete;
+
 	/*
 	 * Register a bean with the manager. The bean will rely on the specified creator for
 	 * bean management/creation.
@@ -39,17 +71,17 @@ public:
 	 * @template Type the type of the bean which is to be registered
 	 * @template Creator the creator which is to be used to instantiate/manage the bean
 	 *           defaults to SingletonBeanCreator. The Creator must provide a method
-	 *           matching the signature of: ValueWrapper<T>* create(), where the returned
-	 *           wrapper is allocated in dynamic memory (i.e.: created via new).
+	 *           matching the signature of: T create(), which returns the bean directly.
 	 *
-	 * @param name std::string the name of the bean to register
+	 * @param name std::string the name of the bean to register (moved into the manager)
 	 *
 	 * @throws InvalidBeanNameException if a bean by that name already exists, or if the bean name is empty
+	 * @throws BeanManagerFrozenException if the manager is frozen
 	 */
 	template<typename Type, class Creator = SingletonBeanCreator<Type>>
 	void registerBean(std::string name) {
 		verifyCanAddBean(name);
-		m_repo[name] = new BeanCreatorProvider<Type, Creator>();
+		addProvider(std::move(name), new BeanCreatorProvider<Type, Creator>());
 	}
 
 	/*
@@ -59,17 +91,52 @@ public:
 	 * to the instance, meaning if it is freed (i.e.: manually, or due to reference going out of scope)
 	 * undefined behavior can be expected.
 	 *
+	 * A scalar instance is copied into the manager exactly once, or moved exactly once when passed as an rvalue
+	 * (see also emplaceBeanInstance). When deduced, the type of the instance decays as it would when passed by value,
+	 * such that a string literal is registered as a const char*.
+	 *
 	 * @template Type the type of the bean which is to be registered
 	 *
-	 * @param name std::string the name of the bean to register
+	 * @param name std::string the name of the bean to register (moved into the manager)
 	 * @param instance Type the bean instance to register
 	 *
 	 * @throws InvalidBeanNameException if a bean by that name already exists, or if the bean name is empty
+	 * @throws BeanManagerFrozenException if the manager is frozen
 	 */
-	template<typename Type>
+	template<typename Type, std::enable_if_t<std::is_reference_v<Type>, int> = 0>
 	void registerBeanInstance(std::string name, Type instance) {
 		verifyCanAddBean(name);
-		m_repo[name] = new BeanInstanceProvider<Type>(instance);
+		addProvider(std::move(name), new BeanInstanceProvider<Type>(instance));
+	}
+
+	template<typename Type, std::enable_if_t<!std::is_reference_v<Type>, int> = 0>
+	void registerBeanInstance(std::string name, const Type& instance) {
+		emplaceBeanInstance<std::decay_t<const Type&>>(std::move(name), instance);
+	}
+
+	template<typename Type, std::enable_if_t<!std::is_reference_v<Type>, int> = 0>
+	void registerBeanInstance(std::string name, Type&& instance) {
+		emplaceBeanInstance<std::decay_t<Type>>(std::move(name), std::move(instance));
+	}
+
+	/*
+	 * Register an instance as a bean under the indicated name, constructing the instance within the manager from
+	 * the specified arguments, such that it is neither copied nor moved. Otherwise the same as registerBeanInstance.
+	 *
+	 * @template Type the type of the bean which is to be registered (a pointer or scalar)
+	 * @template Args the types of the arguments of the constructor
+	 *
+	 * @param name std::string the name of the bean to register (moved into the manager)
+	 * @param args Args&&... the arguments to construct the instance with
+	 *
+	 * @throws InvalidBeanNameException if a bean by that name already exists, or if the bean name is empty
+	 * @throws BeanManagerFrozenException if the manager is frozen
+	 */
+	template<typename Type, typename... Args>
+	void emplaceBeanInstance(std::string name, Args&&... args) {
+		static_assert(!std::is_reference_v<Type>, "a reference instance is registered through registerBeanInstance");
+		verifyCanAddBean(name);
+		addProvider(std::move(name), new BeanInstanceProvider<Type>(std::in_place, std::forward<Args>(args)...));
 	}
 
 	/*
@@ -78,9 +145,18 @@ public:
 	 * registered. Note that any auto-registered beans will be singleton and must have a default
 	 * constructor.
 	 *
+	 * If the desired type is a BeanRef<T>, then the bean is resolved into a handle (equivalent
+	 * to calling getBeanRef<T>).
+	 *
+	 * If the desired type is a const T&, and a scalar instance bean of type T is registered under the
+	 * name (see registerBeanInstance), then a reference to the instance which the manager holds is
+	 * returned, rather than a copy of it. Any other bean of type T (such as a factory) cannot be
+	 * referred to in this manner. Otherwise the bean is retrieved as any other (i.e.: a bean which was
+	 * itself registered as a const T&).
+	 *
 	 * @template Type the type of the bean that is desired
 	 *
-	 * @param name std::string the name of the bean.
+	 * @param name std::string_view the name of the bean. No copy of the name is made in order to look up the bean.
 	 *
 	 * @returns Type the desired bean
 	 *
@@ -88,59 +164,247 @@ public:
 	 * @throws InvalidBeanTypeException if the registered bean is of a different type than what is requested
 	 */
 	template<typename Type>
-	Type getBean(std::string name) {
-		if (!containsBean(name)) {
-#ifdef ENABLE_BEAN_AUTOREGISTRATION
-			registerBean<Type>(name);
-#else
-			throw InvalidBeanNameException(name, "no bean of that name available");
-#endif
-		}
-
-		// check for cycles
-		bool hasCycle = std::find(m_beanNameStack.begin(), m_beanNameStack.end(), name) != m_beanNameStack.end();
-		m_beanNameStack.push_back(name);
-		if (hasCycle)
-			throw BeanDependencyCycleException(m_beanNameStack);
+	Type getBean(std::string_view name) {
+		if constexpr (IsBeanRef<Type>::value) {
+			return getBeanRef<typename Type::BeanType>(name);
+		} else if constexpr (std::is_lvalue_reference_v<Type> && std::is_const_v<std::remove_reference_t<Type>>) {
+			return getInstanceRef<std::remove_const_t<std::remove_reference_t<Type>>>(name);
+		} else {
+			TypeProvider<Type> *typeProvider = resolveProvider<Type>(name);
 
-		BaseProvider *baseProvider = m_repo[name];
-		TypeProvider<Type> *typeProvider = dynamic_cast<TypeProvider<Type>*>(baseProvider);
-
-		if (typeProvider) {
-			Type beanToReturn = typeProvider->getBean();
-			// Only pop the bean from the list if it has been retrieved
-			m_beanNameStack.pop_back();
-			return beanToReturn;
+			// Track the bean for as long as it is being retrieved, to check for cycles
+			ResolutionGuard guard(typeProvider, name);
+			return typeProvider->getBean();
 		}
+	}
 
-		// Do not hold on to invalid bean names in the call stack
-		m_beanNameStack.pop_back();
-		throw InvalidBeanTypeException(name, typeid(Type).name(), baseProvider->getType());
+	/*
+	 * Resolve the bean registered under the specified name into a handle, through which the bean can be
+	 * repeatedly retrieved without looking up the name or checking the type again. The bean itself is not
+	 * retrieved (or created) until the handle is used. Auto registration is applied in the same manner as
+	 * for getBean.
+	 *
+	 * @template Type the type of the bean that is desired
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @returns BeanRef<Type> the handle to the desired bean
+	 *
+	 * @throws InvalidBeanNameException if no bean of the specified name is registered (and auto registration is disabled)
+	 * @throws InvalidBeanTypeException if the registered bean is of a different type than what is requested
+	 */
+	template<typename Type>
+	BeanRef<Type> getBeanRef(std::string_view name) {
+		return BeanRef<Type>(resolveProvider<Type>(name), name);
 	}
 
 	/*
-	 * Convenience method to check if a bean of the given name is already registered.
+	 * Convenience method to check if a bean of the given name is already registered (with the manager or any of its
+	 * parents).
 	 *
-	 * @param name std::string the name of the bean to check for
+	 * @param name std::string_view the name of the bean to check for
 	 *
 	 * @returns bool true if the bean is already registered
 	 */
-	bool containsBean(std::string name);
+	bool containsBean(std::string_view name);
+
+	/*
+	 * Get the parent of the manager.
+	 *
+	 * @returns BeanManager* pointer to the parent, or NULL if the manager has no parent
+	 */
+	BeanManager* getParent() const;
+
+	/*
+	 * Freeze the manager, such that the registered beans can no longer change. Any attempt at registering
+	 * a bean afterwards (including auto registration) results in a BeanManagerFrozenException. Freezing
+	 * an already frozen manager has no effect.
+	 */
+	void freeze();
+
+	/*
+	 * Check whether the manager is frozen.
+	 *
+	 * @returns bool true if the manager is frozen
+	 */
+	bool isFrozen() const;
+
+	/*
+	 * Get a snapshot of the statistics of all beans registered with the manager itself (not those of its parent),
+	 * sorted by name. The statistics are only counted
+	 * while enabled through BeanStatistics::setEnabled (and are all 0 if compiled out).
+	 *
+	 * @returns std::vector<BeanStatisticsEntry> the statistics of each bean
+	 */
+	std::vector<BeanStatisticsEntry> getStatistics() const;
+
+protected:
+	/*
+	 * Called whenever a bean has been registered (including through auto registration), to allow reacting to
+	 * new beans becoming available. Called from the thread which registered the bean, once the bean can be
+	 * retrieved. Does nothing by default.
+	 *
+	 * @param name const std::string& the name of the bean, which remains valid for as long as the manager
+	 */
+	virtual void beanRegistered(const std::string& name);
 
 private:
 	// Repository of all registered beans
-	std::map<std::string, BaseProvider*> m_repo;
-	// Stack for "getBean" calls when there is a chained situation. Used to detect cycles
-	std::vector<std::string> m_beanNameStack;
+	BeanRegistry m_repo;
+	// The manager to fall back to for beans which are not registered (NULL if none)
+	BeanManager* m_parent = NULL;
+
+	/*
+	 * Add the provider to the repository.
+	 *
+	 * @param name std::string&& the name of the bean, which is moved into the repository
+	 * @param provider BaseProvider* the provider of the bean, which is deleted if it cannot be added
+	 *
+	 * @throws InvalidBeanNameException if a bean by that name already exists
+	 * @throws BeanManagerFrozenException if the manager is frozen
+	 */
+	void addProvider(std::string&& name, BaseProvider* provider);
 
 	/*
 	 * Convenience method to check if a bean of the given name can be added to the manager.
 	 *
-	 * @param name std::string the name of the bean to check
+	 * @param name std::string_view the name of the bean to check
 	 *
 	 * @throws InvalidBeanNameException if a bean by that name already exists, or if the bean name is empty
+	 * @throws BeanManagerFrozenException if the manager is frozen
+	 */
+	void verifyCanAddBean(std::string_view name);
+
+	/*
+	 * Find the provider of the bean registered under the specified name, with the manager or else its parents.
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @returns BaseProvider* the provider of the bean, or NULL if none is registered
 	 */
-	void verifyCanAddBean(std::string name);
+	BaseProvider* findProvider(std::string_view name) const {
+		BaseProvider* provider = m_repo.find(name);
+		return provider != NULL || m_parent == NULL ? provider : m_parent->findProvider(name);
+	}
+
+	/*
+	 * Find the provider of the bean registered under the specified name, and make sure that it provides the
+	 * desired type.
+	 *
+	 * @template Type the type of the bean that is desired
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @returns TypeProvider<Type>* the provider of the bean
+	 *
+	 * @throws InvalidBeanNameException if no bean of the specified name is registered (and auto registration is disabled)
+	 * @throws InvalidBeanTypeException if the registered bean is of a different type than what is requested
+	 */
+	template<typename Type>
+	TypeProvider<Type>* resolveProvider(std::string_view name) {
+		// Single probe of the repository (and those of the parents, if missing), the result of which is used for the
+		// remainder of the lookup
+		BaseProvider *baseProvider = findProvider(name);
+		if (baseProvider == NULL) {
+#ifdef ENABLE_BEAN_AUTOREGISTRATION
+			// Automatic singletons are handed out by copy, which a move-only scalar (such as a PooledBean) cannot be
+			if constexpr (!std::is_reference_v<Type> && !std::is_pointer_v<Type> && !std::is_copy_constructible_v<Type>)
+				throw InvalidBeanNameException(std::string(name), "no bean of that name available");
+			else
+				baseProvider = autoRegisterBean<Type>(name);
+#else
+			throw InvalidBeanNameException(std::string(name), "no bean of that name available");
+#endif
+		}
+
+		// The type tags are unique per type, so matching tags guarantee that the provider is a TypeProvider<Type>
+		if (baseProvider->getTypeTag() != typeTag<Type>()) {
+#ifndef DISABLE_CORM_STATISTICS
+			if (BeanStatistics::isEnabled())
+				baseProvider->statistics().countTypeMismatch();
+#endif
+			throw InvalidBeanTypeException(std::string(name), typeName<Type>(), baseProvider->getType());
+		}
+
+#ifndef DISABLE_CORM_STATISTICS
+		if (BeanStatistics::isEnabled())
+			baseProvider->statistics().countLookup();
+#endif
+		return static_cast<TypeProvider<Type>*>(baseProvider);
+	}
+
+	/*
+	 * Get a reference to the instance of the scalar instance bean registered under the specified name, or else the
+	 * bean which was registered as a const reference under that name.
+	 *
+	 * @template Value the type of the scalar
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @returns const Value& the instance
+	 *
+	 * @throws InvalidBeanNameException if no bean of the specified name is registered (and auto registration is disabled)
+	 * @throws InvalidBeanTypeException if the registered bean is neither an instance of type Value, nor a const Value&
+	 */
+	template<typename Value>
+	const Value& getInstanceRef(std::string_view name) {
+		BaseProvider* baseProvider = findProvider(name);
+		if (baseProvider != NULL && baseProvider->getTypeTag() == typeTag<Value>()) {
+			const Value* instance = static_cast<TypeProvider<Value>*>(baseProvider)->getInstance();
+			if (instance == NULL) {
+#ifndef DISABLE_CORM_STATISTICS
+				if (BeanStatistics::isEnabled())
+					baseProvider->statistics().countTypeMismatch();
+#endif
+				throw InvalidBeanTypeException(std::string(name), typeName<const Value&>(), baseProvider->getType());
+			}
+
+#ifndef DISABLE_CORM_STATISTICS
+			if (BeanStatistics::isEnabled())
+				baseProvider->statistics().countLookup();
+#endif
+			return *instance;
+		}
+
+		TypeProvider<const Value&>* typeProvider = resolveProvider<const Value&>(name);
+		ResolutionGuard guard(typeProvider, name);
+		return typeProvider->getBean();
+	}
+
+#ifdef ENABLE_BEAN_AUTOREGISTRATION
+	/*
+	 * Automatically register a singleton bean under the specified name (with the manager itself, rather than its
+	 * parent). If another thread registered a bean under the same name in the meantime, then that bean is used instead.
+	 *
+	 * @template Type the type of the bean to register
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @returns BaseProvider* the provider registered under the name
+	 *
+	 * @throws InvalidBeanNameException if the bean name is empty
+	 * @throws BeanManagerFrozenException if the manager is frozen
+	 */
+	template<typename Type>
+	BaseProvider* autoRegisterBean(std::string_view name) {
+		if (name.empty())
+			throw InvalidBeanNameException(std::string(name), "bean name cannot be empty");
+		else if (isFrozen())
+			throw BeanManagerFrozenException(std::string(name));
+
+		BaseProvider* provider = new BeanCreatorProvider<Type, SingletonBeanCreator<Type>>();
+		const std::string* registeredName = m_repo.insert(std::string(name), provider);
+		if (registeredName == NULL) {
+			delete(provider);
+			if (BaseProvider* existing = m_repo.find(name))
+				return existing;
+			throw BeanManagerFrozenException(std::string(name));
+		}
+
+		beanRegistered(*registeredName);
+		return provider;
+	}
+#endif
 };
 
 }
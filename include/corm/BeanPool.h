@@ -0,0 +1,322 @@
+#ifndef BEANPOOL_H_
+#define BEANPOOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace corm {
+
+template<typename T>
+class BeanPool;
+
+/*
+ * Handle to a bean which was taken from a BeanPool, returning the bean to the pool once released (or once the
+ * handle goes out of scope). The handle owns the bean exclusively, so it can be moved but not copied.
+ *
+ * @template T the type of the bean
+ */
+template<typename T>
+class PooledBean {
+
+public:
+	// CTOR of an empty handle
+	PooledBean() = default;
+
+	/*
+	 * CTOR
+	 *
+	 * @param bean T* pointer to the bean
+	 * @param pool BeanPool<T>* pointer to the pool to return the bean to
+	 */
+	PooledBean(T* bean, BeanPool<T>* pool): m_bean(bean), m_pool(pool) {}
+
+	// DTOR which returns the bean to the pool
+	~PooledBean() {
+		release();
+	}
+
+	// The bean is owned by a single handle at a time
+	PooledBean(const PooledBean&) = delete;
+	PooledBean& operator=(const PooledBean&) = delete;
+
+	// Move CTOR, leaving the other handle empty
+	PooledBean(PooledBean&& other) noexcept: m_bean(other.m_bean), m_pool(other.m_pool) {
+		other.m_bean = NULL;
+	}
+
+	// Move assignment, returning the current bean (if any) to its pool
+	PooledBean& operator=(PooledBean&& other) noexcept {
+		if (this != &other) {
+			release();
+			m_bean = other.m_bean;
+			m_pool = other.m_pool;
+			other.m_bean = NULL;
+		}
+		return *this;
+	}
+
+	/*
+	 * Return the bean to the pool, leaving the handle empty. Has no effect on an empty handle.
+	 */
+	void release() {
+		if (m_bean != NULL) {
+			m_pool->release(m_bean);
+			m_bean = NULL;
+		}
+	}
+
+	/*
+	 * Get the bean.
+	 *
+	 * @return T* pointer to the bean (NULL if the handle is empty)
+	 */
+	T* get() const {
+		return m_bean;
+	}
+
+	T* operator->() const {
+		return m_bean;
+	}
+
+	T& operator*() const {
+		return *m_bean;
+	}
+
+	/*
+	 * Get the pool that the bean was taken from.
+	 *
+	 * @return BeanPool<T>* pointer to the pool (NULL if the handle was never given a bean)
+	 */
+	BeanPool<T>* getPool() const {
+		return m_pool;
+	}
+
+private:
+	// The bean (NULL if the handle is empty)
+	T* m_bean = NULL;
+	// The pool to return the bean to
+	BeanPool<T>* m_pool = NULL;
+};
+
+/*
+ * Bounded pool of bean instances, which are recycled rather than constructed (and destroyed) for every use. The free
+ * instances are kept in a lock-free bounded queue (Vyukov's multi producer/consumer array queue), such that taking or
+ * returning an instance costs a single compare-and-swap, without any lock nor allocation. Should the pool be empty, a
+ * new instance is constructed (a miss), and should the pool be full when an instance is returned, that instance is
+ * destroyed instead (a discard).
+ *
+ * An optional reset hook is applied to every instance that is returned, so that it is handed out again in a clean
+ * state. Should the reset throw, the instance is discarded.
+ *
+ * The pool must outlive all of the handles to its beans.
+ *
+ * @template T the type of the bean, which must be default constructible
+ */
+template<typename T>
+class BeanPool {
+
+public:
+	/*
+	 * CTOR
+	 *
+	 * @param capacity std::size_t the maximum number of free instances kept (rounded up to a power of 2)
+	 * @param reset void (*)(T&) applied to each instance when it is returned (NULL if none)
+	 */
+	explicit BeanPool(std::size_t capacity, void (*reset)(T&) = NULL): m_reset(reset) {
+		std::size_t size = 1;
+		while (size < capacity)
+			size *= 2;
+		m_mask = size - 1;
+		m_cells.reset(new Cell[size]);
+		for (std::size_t i = 0; i < size; i++)
+			m_cells[i].sequence.store(2 * i, std::memory_order_relaxed);
+	}
+
+	// DTOR which destroys the free instances
+	~BeanPool() {
+		while (T* bean = pop())
+			delete(bean);
+	}
+
+	// The handles refer to the pool
+	BeanPool(const BeanPool&) = delete;
+	BeanPool& operator=(const BeanPool&) = delete;
+
+	/*
+	 * Take an instance from the pool, constructing a new one if the pool is empty.
+	 *
+	 * @return PooledBean<T> the handle to the instance
+	 */
+	PooledBean<T> acquire() {
+		return acquire([](auto construct) { return construct(); });
+	}
+
+	/*
+	 * Take an instance from the pool, constructing a new one through the observer if the pool is empty (see
+	 * BeanCreator.h).
+	 *
+	 * @template Observer callable which is given the construction of the instance, returning its outcome
+	 *
+	 * @param observe Observer the observer of the construction
+	 *
+	 * @return PooledBean<T> the handle to the instance
+	 */
+	template<class Observer>
+	PooledBean<T> acquire(Observer observe) {
+		if (T* bean = pop()) {
+			m_hits.fetch_add(1, std::memory_order_relaxed);
+			return PooledBean<T>(bean, this);
+		}
+		m_misses.fetch_add(1, std::memory_order_relaxed);
+		return PooledBean<T>(observe([]() { return new T(); }), this);
+	}
+
+	/*
+	 * Return an instance to the pool (or destroy it, if the pool is full). Used by the handles.
+	 *
+	 * @param bean T* pointer to the instance
+	 */
+	void release(T* bean) noexcept {
+		if (m_reset != NULL) {
+			try {
+				m_reset(*bean);
+			} catch (...) {
+				discard(bean);
+				return;
+			}
+		}
+		if (!push(bean))
+			discard(bean);
+	}
+
+	/*
+	 * Get the maximum number of free instances which the pool keeps.
+	 *
+	 * @return std::size_t the capacity
+	 */
+	std::size_t getCapacity() const {
+		return m_mask + 1;
+	}
+
+	/*
+	 * Get the number of times that an instance was taken from the pool.
+	 *
+	 * @return std::uint64_t the number of hits
+	 */
+	std::uint64_t getHits() const {
+		return m_hits.load(std::memory_order_relaxed);
+	}
+
+	/*
+	 * Get the number of times that a new instance had to be constructed, as the pool was empty.
+	 *
+	 * @return std::uint64_t the number of misses
+	 */
+	std::uint64_t getMisses() const {
+		return m_misses.load(std::memory_order_relaxed);
+	}
+
+	/*
+	 * Get the number of instances which were destroyed on return, as the pool was full (or the reset failed).
+	 *
+	 * @return std::uint64_t the number of discards
+	 */
+	std::uint64_t getDiscards() const {
+		return m_discards.load(std::memory_order_relaxed);
+	}
+
+private:
+	// A single entry of the queue, which is free for the producer at position sequence / 2 (even sequence), or holds
+	// a bean for the consumer at position (sequence - 1) / 2 (odd sequence). Counting two per position keeps a full
+	// cell apart from a cell which is free for the next lap, even when the queue consists of a single cell.
+	struct Cell {
+		std::atomic<std::size_t> sequence;
+		T* bean;
+	};
+
+	// The entries of the queue
+	std::unique_ptr<Cell[]> m_cells;
+	// The number of entries - 1
+	std::size_t m_mask;
+	// Applied to each returned instance (NULL if none)
+	void (*m_reset)(T&);
+	// The position at which the next instance is returned (apart from the one at which it is taken, so that the
+	// producers and consumers do not contend over the same cache line)
+	alignas(64) std::atomic<std::size_t> m_pushPosition{0};
+	// The position at which the next instance is taken
+	alignas(64) std::atomic<std::size_t> m_popPosition{0};
+	// The statistics of the pool
+	alignas(64) std::atomic<std::uint64_t> m_hits{0};
+	std::atomic<std::uint64_t> m_misses{0};
+	std::atomic<std::uint64_t> m_discards{0};
+
+	/*
+	 * Destroy an instance which cannot be kept.
+	 *
+	 * @param bean T* pointer to the instance
+	 */
+	void discard(T* bean) {
+		m_discards.fetch_add(1, std::memory_order_relaxed);
+		delete(bean);
+	}
+
+	/*
+	 * Add the instance to the queue.
+	 *
+	 * @param bean T* pointer to the instance
+	 *
+	 * @return bool false if the queue is full
+	 */
+	bool push(T* bean) {
+		std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &m_cells[position & m_mask];
+			const std::intptr_t diff = std::intptr_t(cell->sequence.load(std::memory_order_acquire)) - std::intptr_t(2 * position);
+			if (diff == 0) {
+				if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return false;
+			} else {
+				position = m_pushPosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->bean = bean;
+		cell->sequence.store(2 * position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 * Take an instance from the queue.
+	 *
+	 * @return T* pointer to the instance, or NULL if the queue is empty
+	 */
+	T* pop() {
+		std::size_t position = m_popPosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &m_cells[position & m_mask];
+			const std::intptr_t diff = std::intptr_t(cell->sequence.load(std::memory_order_acquire)) - std::intptr_t(2 * position + 1);
+			if (diff == 0) {
+				if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return NULL;
+			} else {
+				position = m_popPosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		T* bean = cell->bean;
+		cell->sequence.store(2 * (position + m_mask + 1), std::memory_order_release);
+		return bean;
+	}
+};
+
+}
+
+#endif /* BEANPOOL_H_ */
@@ -2,8 +2,14 @@
 #define BEANPROVIDER_H_
 
 #include "BeanCreator.h"
+#include "BeanStatistics.h"
+#include "Trace.h"
+#include "TypeTag.h"
+#include <atomic>
+#include <chrono>
 #include <type_traits>
 #include <string>
+#include <utility>
 
 namespace corm {
 
@@ -14,7 +20,11 @@ namespace corm {
 class BaseProvider {
 public:
 	// DTOR
-	virtual ~BaseProvider() = default;
+	virtual ~BaseProvider() {
+#ifndef DISABLE_CORM_STATISTICS
+		delete(m_statistics.load(std::memory_order_relaxed));
+#endif
+	}
 
 	/*
 	 * Get the type of the bean as a string. Intended to be used purely for debugging purposes.
@@ -22,6 +32,85 @@ public:
 	 * @returns std::string the type of the bean as a string
 	 */
 	virtual std::string getType() = 0;
+
+	/*
+	 * Get the tag of the type of the bean, which can be compared against corm::typeTag<T>() to check whether
+	 * the provider provides beans of type T.
+	 *
+	 * @returns TypeTag the tag of the type of the bean
+	 */
+	TypeTag getTypeTag() const {
+		return m_typeTag;
+	}
+
+#ifndef DISABLE_CORM_STATISTICS
+	/*
+	 * Get the statistics of the bean.
+	 *
+	 * @returns const BeanStatistics* pointer to the statistics, or NULL if nothing was counted yet
+	 */
+	const BeanStatistics* getStatistics() const {
+		return m_statistics.load(std::memory_order_acquire);
+	}
+
+	/*
+	 * Get the statistics of the bean for counting, allocating them the first time.
+	 *
+	 * @returns BeanStatistics& the statistics
+	 */
+	BeanStatistics& statistics() {
+		BeanStatistics* current = m_statistics.load(std::memory_order_acquire);
+		if (current != NULL)
+			return *current;
+
+		// Should another thread install its statistics first, then those are used instead
+		BeanStatistics* created = new BeanStatistics();
+		if (m_statistics.compare_exchange_strong(current, created, std::memory_order_acq_rel))
+			return *created;
+		delete(created);
+		return *current;
+	}
+#endif
+
+#ifdef ENABLE_CORM_TRACING
+	/*
+	 * Set the name under which the provider is registered, so that its beans can be identified within the trace.
+	 *
+	 * @param name const std::string* pointer to the name, which must outlive the provider
+	 */
+	void setTraceName(const std::string* name) {
+		m_traceName = name;
+	}
+#endif
+
+protected:
+	// CTOR
+	BaseProvider(TypeTag typeTag): m_typeTag(typeTag) {}
+
+#ifdef ENABLE_CORM_TRACING
+	// Whether an instance of the bean was already (successfully) created, so that only the first creation is traced
+	std::atomic<bool> m_created{false};
+
+	// The name under which the provider is registered (if known)
+	const std::string* m_traceName = NULL;
+
+	/*
+	 * Get the name to identify the beans of the provider within the trace.
+	 *
+	 * @return std::string the name of the bean, or its type if the name is not known
+	 */
+	std::string getTraceName() {
+		return m_traceName == NULL ? getType() : *m_traceName;
+	}
+#endif
+
+private:
+	// The tag of the type of the bean that is provided
+	const TypeTag m_typeTag;
+#ifndef DISABLE_CORM_STATISTICS
+	// The statistics of the bean, NULL until first counted
+	std::atomic<BeanStatistics*> m_statistics{NULL};
+#endif
 };
 
 /*
@@ -33,6 +122,8 @@ template<typename T>
 class TypeProvider: public BaseProvider {
 
 public:
+	// CTOR
+	TypeProvider(): BaseProvider(typeTag<T>()) {}
 	// DTOR
 	virtual ~TypeProvider() = default;
 
@@ -42,55 +133,108 @@ public:
 	 * @returns std::string the type of the bean as a string
 	 */
 	virtual std::string getType() {
-		return typeid(T).name();
+		return typeName<T>();
 	}
 
 	/*
 	 * Get the bean instance that this provider provides. Note that this class does not actually create
-	 * the bean, and instead relies on a sub class to handle the bean creation.
+	 * the bean, and instead relies on a sub class to handle the bean creation. The bean is returned
+	 * directly, meaning that retrieving a bean requires no interim (heap) storage, and that the bean is
+	 * moved (rather than copied) all the way from its creator to the caller. Move-only beans (such as
+	 * those of a SmartFactoryBeanCreator<T, std::unique_ptr>) are therefore supported.
+	 *
+	 * @return T the bean
 	 */
-	T getBean() {
-		// The expectation is that the subclass will populate the bean instance field within the initBean method
-		provideBean();
-
-		// Bit of a roundabout way to do this, but required in order to get around the limitations of C++.
-		// Retrieve the bean from the interim ValueWrapper, and make sure that the ValueWrapper is deallocated
-		// to avoid leaking memory.
-		T bean = m_beanWrapper->m_value;
-		delete(m_beanWrapper);
-		m_beanWrapper = NULL;
-		return bean;
-	}
-
-protected:
-	// This is an interim storage vehicle where the bean created by the subclass is to be stored.
-	ValueWrapper<T>* m_beanWrapper = NULL;
+	virtual T getBean() = 0;
 
 	/*
-	 * Provide the bean by storing it within the interim ValueWrapper beanWrapper. Note that this *must* be allocated
-	 * via new, as getBean will be cleaning up this memory after it has retrieved the wrapper value.
+	 * Get the instance which the provider holds, so that it can be referred to rather than copied. Only the providers
+	 * of instance beans hold their instance, all others create (or copy) the bean with each retrieval.
+	 *
+	 * @return const T* pointer to the instance, or NULL if the provider holds none
 	 */
-	virtual void provideBean() = 0;
+	virtual std::add_pointer_t<const T> getInstance() const {
+		return NULL;
+	}
 };
 
 /*
- * Provides the beanWrapper that the Creator creates. This class primarily exists to make
+ * Provides the bean that the Creator creates. This class primarily exists to make
  * the relationship between the Bean and Creator explicitly clear, and hide the details
  * of it from the BeanManager class.
  */
 template<typename T, class Creator>
 class BeanCreatorProvider: public TypeProvider<T> {
 
+public:
+	/*
+	 * The creator creates the bean, which is passed directly on to the caller
+	 */
+	T getBean() {
+#if defined(ENABLE_CORM_TRACING) || !defined(DISABLE_CORM_STATISTICS)
+		if constexpr (ReusesInstance<Creator>::value) {
+			// Only the instances which the creator actually constructs count as created
+			return m_creator.create([this](auto construct) -> decltype(auto) { return this->observeCreation(construct); });
+		} else {
+			// Every call creates a new bean
+			return observeCreation([this]() -> T { return m_creator.create(); });
+		}
+#else
+		return m_creator.create();
+#endif
+	}
+
 private:
 	// The creator for determining how to create bean instances
 	Creator m_creator;
 
+#if defined(ENABLE_CORM_TRACING) || !defined(DISABLE_CORM_STATISTICS)
 	/*
-	 * The creator creates the beanWrapper and store the resulting beanWrapper in the interim beanWrapper instance field container
+	 * Perform the creation of a bean (or of an instance which the creator reuses), counting (and timing) it while the
+	 * statistics are enabled. The first creation which succeeds is traced (should several threads race to be the first,
+	 * each of them is traced).
+	 *
+	 * @template Create callable which performs the creation
+	 *
+	 * @param create Create the creation
+	 *
+	 * @return the outcome of the creation
+	 */
+	template<typename Create>
+	decltype(auto) observeCreation(Create create) {
+#ifdef ENABLE_CORM_TRACING
+		if (!this->m_created.load(std::memory_order_relaxed)) {
+			CORM_TRACE_SCOPE("bean", this->getTraceName());
+			decltype(auto) created = countCreation(create);
+			this->m_created.store(true, std::memory_order_relaxed);
+			return created;
+		}
+#endif
+		return countCreation(create);
+	}
+
+	/*
+	 * Perform the creation, counting (and timing) it while the statistics are enabled.
+	 *
+	 * @template Create callable which performs the creation
+	 *
+	 * @param create Create the creation
+	 *
+	 * @return the outcome of the creation
 	 */
-	void provideBean() {
-		TypeProvider<T>::m_beanWrapper = m_creator.create();
+	template<typename Create>
+	decltype(auto) countCreation(Create create) {
+#ifndef DISABLE_CORM_STATISTICS
+		if (BeanStatistics::isEnabled()) {
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			decltype(auto) created = create();
+			this->statistics().countCreation(std::chrono::steady_clock::now() - start);
+			return created;
+		}
+#endif
+		return create();
 	}
+#endif
 };
 
 /*
@@ -98,24 +242,42 @@ private:
  */
 template<typename T>
 class BeanInstanceProvider: public TypeProvider<T> {
+	static_assert(std::is_copy_constructible_v<T>,
+			"an instance bean is handed out by copy, a move-only bean must be provided by a creator instead");
+
 public:
 	/*
 	 * Create the provider with the instance that is to be provided
 	 */
 	BeanInstanceProvider(T instance) :
-			m_instance(instance) {
+			m_instance(std::forward<T>(instance)) {
 	}
 
-private:
-	// The instance passed to the provider
-	T m_instance;
+	/*
+	 * Create the provider with the instance constructed in place, from the specified arguments
+	 */
+	template<typename... Args>
+	explicit BeanInstanceProvider(std::in_place_t, Args&&... args) :
+			m_instance(std::forward<Args>(args)...) {
+	}
 
 	/*
-	 * Provides the instance by passing it to interim beanWrapper instance field container
+	 * Provides the instance that was given to the provider
 	 */
-	void provideBean() {
-		TypeProvider<T>::m_beanWrapper = new ValueWrapper<T>(m_instance);
+	T getBean() {
+		return m_instance;
+	}
+
+	/*
+	 * Provides the instance itself (for scalars, to be referred to without copying)
+	 */
+	std::add_pointer_t<const T> getInstance() const {
+		return &m_instance;
 	}
+
+private:
+	// The instance passed to the provider
+	T m_instance;
 };
 
 }
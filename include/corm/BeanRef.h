@@ -0,0 +1,95 @@
+#ifndef BEANREF_H_
+#define BEANREF_H_
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "BeanProvider.h"
+#include "ResolutionGuard.h"
+
+namespace corm {
+
+/*
+ * Handle to a bean that has been resolved (by name and type) ahead of time. Retrieving the bean through
+ * the handle goes directly to the provider of the bean, without having to look up the name or check the
+ * type of the bean again. Note that the handle is tied to the BeanManager which it was resolved from,
+ * and must not be used after that BeanManager is destroyed. Retrieving a bean through the handle is checked for
+ * cycles in the same manner as through BeanManager::getBean, which is why the handle keeps the name of the bean.
+ *
+ * Handles are created via BeanManager::getBeanRef, or can be declared as a resource within a configuration:
+ *
+ * 		RESOURCES(
+ * 				(corm::BeanRef<DummyClass*>, someBean)
+ * 		)
+ *
+ * @template T the type of the bean that is referenced
+ */
+template<typename T>
+class BeanRef {
+
+public:
+	// The type of the bean that is referenced
+	typedef T BeanType;
+
+	// CTOR for an unresolved handle
+	BeanRef() = default;
+
+	/*
+	 * CTOR for a handle to the specified provider.
+	 *
+	 * @param provider TypeProvider<T>* the provider of the bean
+	 * @param name std::string_view the name under which the bean is registered (copied into the handle)
+	 */
+	BeanRef(TypeProvider<T>* provider, std::string_view name): m_provider(provider), m_name(name) {}
+
+	/*
+	 * Get the bean that is referenced by the handle. The bean is provided in the same manner as it would
+	 * be through BeanManager::getBean (i.e.: a factory will create a new instance with each call).
+	 *
+	 * @return T the referenced bean
+	 *
+	 * @throws BeanDependencyCycleException if the bean is already being retrieved by the current thread
+	 */
+	T get() const {
+		ResolutionGuard guard(m_provider, m_name);
+		return m_provider->getBean();
+	}
+
+	/*
+	 * Convenience shorthand for get().
+	 *
+	 * @return T the referenced bean
+	 */
+	T operator()() const {
+		return get();
+	}
+
+	/*
+	 * Check whether the handle has been resolved to a bean.
+	 *
+	 * @return bool true if the handle refers to a bean
+	 */
+	bool isResolved() const {
+		return m_provider != NULL;
+	}
+
+private:
+	// The provider of the referenced bean
+	TypeProvider<T>* m_provider = NULL;
+	// The name of the referenced bean, to report within a cycle
+	std::string m_name;
+};
+
+/*
+ * Trait to determine whether or not a type is a BeanRef.
+ */
+template<typename T>
+struct IsBeanRef: std::false_type {};
+
+template<typename T>
+struct IsBeanRef<BeanRef<T>>: std::true_type {};
+
+}
+
+#endif /* BEANREF_H_ */
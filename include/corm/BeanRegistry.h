@@ -0,0 +1,175 @@
+#ifndef BEANREGISTRY_H_
+#define BEANREGISTRY_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BeanProvider.h"
+#include "FrozenBeanTable.h"
+
+namespace corm {
+
+/*
+ * Hashed repository of bean providers, keyed by the name of the bean. The registry is an open addressing
+ * (linear probing) hash table, which allows looking up a bean through a std::string_view (or anything that
+ * converts to one, such as a const char*) without having to construct a temporary std::string. A lookup is
+ * a single probe sequence, where the full name is only compared when the stored hash matches.
+ *
+ * The registry is safe to use concurrently. Beans can only ever be added (never removed or replaced), which
+ * allows lookups to be entirely lock-free:
+ *        * each bean is stored in an immutable entry, which is published to its slot only once fully built
+ *        * when the table must grow, a new table is built on the side (sharing the existing entries) and then
+ *          published in place of the old one. Lookups which are still probing the old table remain valid, as
+ *          old tables are only reclaimed when the registry itself is destroyed (since the table size doubles
+ *          each time, the retired tables never take up more memory than the current one).
+ * Insertions are serialized through a mutex, which lookups never touch.
+ *
+ * Once all beans are registered, the registry can be frozen. This compiles all of the beans into a
+ * FrozenBeanTable, through which all subsequent lookups are performed, and rejects any further insertion.
+ *
+ * Note that the registry does not own the providers that it stores, that is left up to the BeanManager.
+ */
+class BeanRegistry {
+
+public:
+	// CTOR
+	BeanRegistry() = default;
+	// DTOR
+	~BeanRegistry();
+
+	// The registry is shared by reference only
+	BeanRegistry(const BeanRegistry&) = delete;
+	BeanRegistry& operator=(const BeanRegistry&) = delete;
+
+	/*
+	 * Find the provider that is registered under the given name. This never blocks.
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @return BaseProvider* pointer to the provider, or NULL if no bean is registered under that name
+	 */
+	BaseProvider* find(std::string_view name) const {
+		const FrozenBeanTable* frozen = m_frozenTable.load(std::memory_order_acquire);
+		if (frozen != NULL)
+			return frozen->find(name);
+		return findInTable(name);
+	}
+
+	/*
+	 * Insert the provider under the given name.
+	 *
+	 * @param name std::string&& the name of the bean, which is only moved from if the provider is inserted
+	 * @param provider BaseProvider* pointer to the provider of the bean (cannot be NULL)
+	 *
+	 * @return const std::string* pointer to the name as stored within the registry (valid for as long as the registry)
+	 *         if the provider was inserted, NULL if a bean of that name is already registered or if the registry is frozen
+	 */
+	const std::string* insert(std::string&& name, BaseProvider* provider);
+
+	/*
+	 * Freeze the registry, such that no further bean can be inserted. Freezing an already frozen registry
+	 * has no effect.
+	 */
+	void freeze();
+
+	/*
+	 * Check whether the registry is frozen.
+	 *
+	 * @return bool true if the registry is frozen
+	 */
+	bool isFrozen() const;
+
+	/*
+	 * Get the number of beans stored within the registry.
+	 *
+	 * @return std::size_t the number of beans
+	 */
+	std::size_t size() const;
+
+	/*
+	 * Apply the function to each bean stored within the registry. The order in which the beans are visited
+	 * is unspecified. Insertions are blocked while the beans are being visited.
+	 *
+	 * @template Func callable matching the signature of void(const std::string&, BaseProvider*)
+	 *
+	 * @param func Func the function to apply
+	 */
+	template<typename Func>
+	void forEach(Func func) const {
+		std::lock_guard<std::mutex> lock(m_writeLock);
+		const Table* table = m_table.load(std::memory_order_acquire);
+		if (table == NULL)
+			return;
+
+		for (std::size_t i = 0; i <= table->mask; i++) {
+			const Entry* entry = table->slots[i].load(std::memory_order_acquire);
+			if (entry != NULL)
+				func(entry->name, entry->provider);
+		}
+	}
+
+private:
+	// A single bean within the registry. Immutable once published.
+	struct Entry {
+		std::size_t hash;
+		std::string name;
+		BaseProvider* provider;
+	};
+
+	// A generation of the table, the size of which is always a power of two. A slot is empty when it has no entry.
+	struct Table {
+		std::size_t mask;
+		std::unique_ptr<std::atomic<const Entry*>[]> slots;
+
+		Table(std::size_t capacity);
+	};
+
+	// The current table, or NULL when nothing was yet inserted
+	std::atomic<const Table*> m_table{NULL};
+	// All tables which were ever published (including the current one), reclaimed with the registry
+	std::vector<std::unique_ptr<Table>> m_tables;
+	// The number of beans within the registry
+	std::atomic<std::size_t> m_size{0};
+	// Serializes the insertions
+	mutable std::mutex m_writeLock;
+	// Whether or not the registry is frozen
+	std::atomic<bool> m_frozen{false};
+	// The table compiled when the registry was frozen, or NULL while not frozen
+	std::atomic<const FrozenBeanTable*> m_frozenTable{NULL};
+	// Owner of the frozen table
+	std::unique_ptr<FrozenBeanTable> m_frozenTableOwner;
+
+	/*
+	 * Find the provider through the (open addressing) table.
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @return BaseProvider* pointer to the provider, or NULL if no bean is registered under that name
+	 */
+	BaseProvider* findInTable(std::string_view name) const;
+
+	/*
+	 * Hash the name of a bean.
+	 *
+	 * @param name std::string_view the name to hash
+	 *
+	 * @return std::size_t the hash
+	 */
+	static std::size_t hash(std::string_view name);
+
+	/*
+	 * Build the next (double sized, or initial) table with all of the existing entries, and publish it. Must
+	 * only be called while holding the write lock.
+	 *
+	 * @return Table* pointer to the new current table
+	 */
+	Table* grow();
+};
+
+}
+
+#endif /* BEANREGISTRY_H_ */
@@ -0,0 +1,181 @@
+#ifndef BEANSCOPE_H_
+#define BEANSCOPE_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include "exception/InvalidBeanException.h"
+
+namespace corm {
+
+/*
+ * Scope for the beans which only live for a single unit of work (i.e.: a request). The beans of a scope are created
+ * by the scoped creators (see ScopedBeanCreator and ScopedFactoryBeanCreator) within a monotonic arena owned by the
+ * scope, and are all released at once when the scope ends (or is reset): their destructors are run (in the reverse
+ * order of creation), and the arena is rewound, without freeing any of the beans individually. The arena starts out
+ * within the scope itself, so a scope holding only a few small beans performs no allocation at all.
+ *
+ * A scope is active on the thread which created it, from its creation until its destruction, such that the scoped
+ * creators use the innermost active scope of the thread retrieving the bean. A scope must therefore be destroyed on
+ * the thread which created it, in the reverse order of creation of the scopes of that thread (as is the case for a
+ * scope on the stack). Note that a scoped bean must not be used once its scope has ended.
+ */
+class BeanScope {
+
+public:
+	// CTOR, which makes the scope active on the current thread
+	BeanScope();
+
+	// DTOR, which releases all beans of the scope and makes the previously active scope active again
+	~BeanScope();
+
+	// The scope is tied to the thread (and typically the stack frame) in which it was created
+	BeanScope(const BeanScope&) = delete;
+	BeanScope& operator=(const BeanScope&) = delete;
+
+	/*
+	 * Get the innermost scope which is active on the current thread.
+	 *
+	 * @return BeanScope* pointer to the scope, or NULL if no scope is active
+	 */
+	static BeanScope* current();
+
+	/*
+	 * Get the innermost scope which is active on the current thread, which must exist.
+	 *
+	 * @return BeanScope& the scope
+	 *
+	 * @throws NoActiveBeanScopeException if no scope is active on the current thread
+	 */
+	static BeanScope& requireCurrent();
+
+	/*
+	 * Create a new (default constructed) bean within the scope.
+	 *
+	 * @template T the type of the bean to create
+	 *
+	 * @return T* pointer to the bean, which remains owned by the scope
+	 */
+	template<typename T>
+	T* create() {
+		// Allocate the cleanup first, so that nothing can fail once the bean is constructed
+		Cleanup* cleanup = NULL;
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			cleanup = static_cast<Cleanup*>(m_arena.allocate(sizeof(Cleanup), alignof(Cleanup)));
+
+		T* bean = new (m_arena.allocate(sizeof(T), alignof(T))) T();
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			cleanup->destroy = &destroy<T>;
+			cleanup->bean = bean;
+			cleanup->next = m_cleanups;
+			m_cleanups = cleanup;
+		}
+		m_numBeans++;
+		return bean;
+	}
+
+	/*
+	 * Get the single instance of the bean within the scope, for the given key, creating it on first request.
+	 *
+	 * @template T the type of the bean
+	 *
+	 * @param key const void* identifies the bean within the scope (i.e.: the creator of the bean)
+	 *
+	 * @return T* pointer to the bean, which remains owned by the scope
+	 */
+	template<typename T>
+	T* getInstance(const void* key) {
+		return getInstance<T>(key, [](auto construct) { return construct(); });
+	}
+
+	/*
+	 * Get the single instance of the bean within the scope, for the given key, creating it on first request through
+	 * the observer (see BeanCreator.h).
+	 *
+	 * @template T the type of the bean
+	 * @template Observer callable which is given the creation of the instance, returning its outcome
+	 *
+	 * @param key const void* identifies the bean within the scope (i.e.: the creator of the bean)
+	 * @param observe Observer the observer of the creation
+	 *
+	 * @return T* pointer to the bean, which remains owned by the scope
+	 */
+	template<typename T, class Observer>
+	T* getInstance(const void* key, Observer observe) {
+		// A scope typically holds no more than a handful of beans
+		for (const Instance* i = m_instances; i != NULL; i = i->next) {
+			if (i->key == key)
+				return static_cast<T*>(i->bean);
+		}
+
+		Instance* instance = static_cast<Instance*>(m_arena.allocate(sizeof(Instance), alignof(Instance)));
+		T* bean = observe([this]() { return create<T>(); });
+		*instance = Instance{key, bean, m_instances};
+		m_instances = instance;
+		return bean;
+	}
+
+	/*
+	 * Release all beans of the scope, which remains active and can be reused for the next unit of work.
+	 */
+	void reset();
+
+	/*
+	 * Get the number of beans which were created within the scope (since it was last reset).
+	 *
+	 * @return std::size_t the number of beans
+	 */
+	std::size_t size() const;
+
+private:
+	// The size of the arena within the scope itself
+	static constexpr std::size_t INITIAL_ARENA_SIZE = 512;
+
+	// The destruction of a bean which is not trivially destructible, kept in the reverse order of creation
+	struct Cleanup {
+		void (*destroy)(void*);
+		void* bean;
+		Cleanup* next;
+	};
+
+	// The single instance of a bean within the scope
+	struct Instance {
+		const void* key;
+		void* bean;
+		Instance* next;
+	};
+
+	// The part of the arena which is within the scope itself
+	alignas(std::max_align_t) std::byte m_initialArena[INITIAL_ARENA_SIZE];
+	// The arena in which all beans (and the bookkeeping thereof) are allocated
+	std::pmr::monotonic_buffer_resource m_arena;
+	// The most recently created bean which requires destruction
+	Cleanup* m_cleanups = NULL;
+	// The most recently created single instance
+	Instance* m_instances = NULL;
+	// The number of beans created
+	std::size_t m_numBeans = 0;
+	// The scope which was active on the thread when this one was created
+	BeanScope* m_previous;
+
+	// The innermost active scope of each thread
+	static thread_local BeanScope* s_current;
+
+	/*
+	 * Destroy a bean without freeing its memory.
+	 *
+	 * @template T the type of the bean
+	 *
+	 * @param bean void* pointer to the bean
+	 */
+	template<typename T>
+	static void destroy(void* bean) {
+		static_cast<T*>(bean)->~T();
+	}
+};
+
+}
+
+#endif /* BEANSCOPE_H_ */
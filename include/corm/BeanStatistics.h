@@ -0,0 +1,143 @@
+#ifndef BEANSTATISTICS_H_
+#define BEANSTATISTICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace corm {
+
+/*
+ * Counters of how a single bean is used. The counters are only updated while the statistics are enabled (which
+ * they are not by default), and can be compiled out entirely by defining DISABLE_CORM_STATISTICS (-DDISABLE_STATISTICS=ON
+ * with cmake). When compiled in but disabled, the cost to retrieving a bean is a single (relaxed) atomic load.
+ *
+ * All counters are relaxed atomics, and each bean has its counters on a cache line of their own (only allocated once
+ * the bean is first counted), so that counting does not slow down the retrieval of any other bean.
+ */
+class alignas(64) BeanStatistics {
+
+public:
+	/*
+	 * Enable or disable the counting of the statistics, for all beans of all managers.
+	 *
+	 * @param enabled bool true to start counting, false to stop
+	 */
+	static void setEnabled(bool enabled);
+
+	/*
+	 * Check whether the statistics are being counted.
+	 *
+	 * @return bool true if counting
+	 */
+	static bool isEnabled() {
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	/*
+	 * Count a successful lookup of the bean by name.
+	 */
+	void countLookup() {
+		m_lookups.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/*
+	 * Count a lookup of the bean by name, for which the wrong type was requested.
+	 */
+	void countTypeMismatch() {
+		m_typeMismatches.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/*
+	 * Count the creation of a bean (or of an instance which the creator reuses).
+	 *
+	 * @param time std::chrono::steady_clock::duration the time spent creating
+	 */
+	void countCreation(std::chrono::steady_clock::duration time) {
+		m_creations.fetch_add(1, std::memory_order_relaxed);
+		m_creationTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+				std::memory_order_relaxed);
+	}
+
+	/*
+	 * Get the number of successful lookups.
+	 *
+	 * @return std::uint64_t the number of lookups
+	 */
+	std::uint64_t getLookups() const;
+
+	/*
+	 * Get the number of lookups for the wrong type.
+	 *
+	 * @return std::uint64_t the number of type mismatches
+	 */
+	std::uint64_t getTypeMismatches() const;
+
+	/*
+	 * Get the number of creations: for a factory, the number of calls to the create method of the creator, while for
+	 * a creator which reuses its instances, the number of instances which it constructed (see BeanCreator.h).
+	 *
+	 * @return std::uint64_t the number of creations
+	 */
+	std::uint64_t getCreations() const;
+
+	/*
+	 * Get the total time spent creating.
+	 *
+	 * @return std::chrono::nanoseconds the total time
+	 */
+	std::chrono::nanoseconds getCreationTime() const;
+
+private:
+	// Whether the statistics are being counted
+	static std::atomic<bool> s_enabled;
+
+	std::atomic<std::uint64_t> m_lookups{0};
+	std::atomic<std::uint64_t> m_typeMismatches{0};
+	std::atomic<std::uint64_t> m_creations{0};
+	// In nanoseconds
+	std::atomic<std::int64_t> m_creationTime{0};
+};
+
+/*
+ * Snapshot of the statistics of a single bean.
+ */
+struct BeanStatisticsEntry {
+	// The name of the bean
+	std::string name;
+	// The type of the bean
+	std::string type;
+	// The number of successful lookups
+	std::uint64_t lookups;
+	// The number of lookups for the wrong type
+	std::uint64_t typeMismatches;
+	// The number of creations (see BeanStatistics::getCreations)
+	std::uint64_t creations;
+	// The total time spent creating
+	std::chrono::nanoseconds creationTime;
+};
+
+/*
+ * Write the statistics as text, one bean per line.
+ *
+ * @param os std::ostream& the stream to write to
+ * @param statistics const std::vector<BeanStatisticsEntry>& the statistics to write
+ */
+void writeStatisticsText(std::ostream& os, const std::vector<BeanStatisticsEntry>& statistics);
+
+/*
+ * Write the statistics as JSON, in the form of:
+ *
+ * 		{"beans": [{"name": "bean", "type": "int", "lookups": 1, "typeMismatches": 0, "creations": 1, "creationTimeNs": 10}, ...]}
+ *
+ * @param os std::ostream& the stream to write to
+ * @param statistics const std::vector<BeanStatisticsEntry>& the statistics to write
+ */
+void writeStatisticsJson(std::ostream& os, const std::vector<BeanStatisticsEntry>& statistics);
+
+}
+
+#endif /* BEANSTATISTICS_H_ */
@@ -1,22 +1,30 @@
 #ifndef CIRCULARDEPENDENCYCHECKER_H_
 #define CIRCULARDEPENDENCYCHECKER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <map>
 
 namespace corm {
 
 /*
  * Helper class that checks to see whether or not a circular dependency is present between
  * configuration files.
+ *
+ * The configurations form a graph, where each configuration (identified by an integer) depends on the
+ * configurations which provide its resources. The strongly connected components of the graph are found
+ * through an (iterative) Tarjan's algorithm, and each component that contains a cycle is reported as the
+ * shortest cycle through its first added configuration. The check is therefore linear in the number of
+ * configurations plus the number of resources, regardless of the shape of the graph.
  */
 class CircularDependencyChecker {
 
 public:
 
 	/*
-	 * Add the details of a single configuration file.
+	 * Add the details of a single configuration file. Adding the same configuration again replaces its details.
 	 *
 	 * @param name std::string the name of the configuration file
 	 * @param resources std::vector<std::string> containing the names of all of the resources within
@@ -34,44 +42,71 @@ public:
 	bool checkForCycle();
 
 	/*
-	 * Get the vector which describes the cycle, indicating where the cycle takes place.
+	 * Get the vector which describes the (first) cycle, indicating where the cycle takes place. Each entry is
+	 * of the form "Configuration::resource", starting and ending with the same entry (i.e.: A::x -> B::y -> A::x).
 	 *
 	 * @return std::vector<std::string> indicating the configurations and resources across which the cycle can be found
 	 */
 	const std::vector<std::string>& getCycle();
 
+	/*
+	 * Get all of the cycles that were detected, one for each group of configurations which depend on each other.
+	 *
+	 * @return std::vector<std::vector<std::string>> the cycles, each in the same format as getCycle
+	 */
+	const std::vector<std::vector<std::string>>& getCycles();
+
 private:
-	// Map of all beans to the configuration that provides it
-	std::map<std::string, std::string> m_beanSource;
-	// Map of configuration names to the resources they require
-	std::map<std::string, std::vector<std::string>> m_configResources;
-	// Vector acting as a stack to determine whether a cycle is present
-	std::vector<std::string> m_cycle;
+	// A dependency of a configuration on another configuration, through one of its resources
+	struct Dependency {
+		// The configuration which requires the resource
+		std::size_t dependent;
+		// The configuration which provides the resource
+		std::size_t provider;
+		// The index of the resource within the resources of the dependent configuration
+		std::size_t resource;
+	};
+
+	// Marks a configuration which was not (yet) reached while searching
+	static constexpr std::size_t NOT_REACHED = SIZE_MAX;
+
+	// The name of each configuration, where the index is the id of the configuration
+	std::vector<std::string> m_configNames;
+	// The resources that each configuration requires (by configuration id)
+	std::vector<std::vector<std::string>> m_configResources;
+	// Map of configuration names to their id
+	std::unordered_map<std::string, std::size_t> m_configIds;
+	// Map of all beans to the id of the configuration that provides it
+	std::unordered_map<std::string, std::size_t> m_beanSource;
+	// The cycles that were detected
+	std::vector<std::vector<std::string>> m_cycles;
+
+	// The dependencies of all configurations, grouped by configuration
+	std::vector<Dependency> m_dependencies;
+	// Where the dependencies of each configuration start within m_dependencies (one extra entry marks the end)
+	std::vector<std::size_t> m_firstDependency;
 
 	/*
-	 * Check all of the resources belonging to the configuration file, to determine whether a cycle is present.
-	 *
-	 * @param configName std::string the name of the configuration file to check
-	 *
-	 * @return true if a cycle was detected
+	 * Resolve the resources of all configurations into the dependencies between them.
 	 */
-	bool checkAllResources(std::string configName);
+	void buildDependencies();
 
 	/*
-	 * Follow the resource that the configuration requires.
+	 * Find the strongly connected components of the configurations.
 	 *
-	 * @param configName std::string the name of the configuration
-	 * @param resourceName std::string the name of the resource
-	 *
-	 * @return true if a cycle was detected
+	 * @return std::vector<std::size_t> the component of each configuration (by configuration id)
 	 */
-	bool followResource(std::string configName, std::string resourceName);
+	std::vector<std::size_t> findComponents() const;
 
 	/*
-	 * Minimize the reported cycle to the smallest it can be. This will discard any extraneous "path" that was traveled prior
-	 * to detecting the cycle itself. For example 1 -> 2 -> 3 -> 4 -> 3 will minimize such that it only report 3 -> 4 -> 3.
+	 * Find the shortest cycle through the configuration, staying within its component, and record it.
+	 *
+	 * @param start std::size_t the id of the configuration
+	 * @param components const std::vector<std::size_t>& the component of each configuration
+	 * @param reachedThrough std::vector<std::size_t>& scratch space, holding for each configuration the dependency
+	 *        through which it was reached (must be all NOT_REACHED, and is left that way)
 	 */
-	void minimizeCycle();
+	void recordCycle(std::size_t start, const std::vector<std::size_t>& components, std::vector<std::size_t>& reachedThrough);
 };
 
 }
@@ -1,6 +1,7 @@
 #ifndef CONFIGURATION_H_
 #define CONFIGURATION_H_
 
+#include <algorithm>
 #include <vector>
 
 #include "ConfigurationMacro.h"
@@ -155,7 +156,7 @@ public:
 	 */
 	virtual bool areResourcesSatisfied() {
 		m_waitingResources.erase(std::remove_if(m_waitingResources.begin(), m_waitingResources.end(),
-				[this](std::string s) { return m_beanManager->containsBean(s); }), m_waitingResources.end());
+				[this](const std::string& s) { return m_beanManager->containsBean(s); }), m_waitingResources.end());
 		return m_waitingResources.empty();
 	}
 
@@ -67,7 +67,8 @@
 
 
 
-// Macros which allows for short handing the creation/definition of resources
+// Macros which allows for short handing the creation/definition of resources. When the Type is a corm::BeanRef<T>
+// the resource is declared as a handle to the bean, rather than a copy of it.
 #define RESOURCE3(Type, Name, Var) Type Var = m_beanManager->getBean<Type>(Name);
 #define RESOURCE2(Type, Var) RESOURCE3(Type, #Var, Var)
 #define RESOURCE(...) macro_dispatcher(RESOURCE, __VA_ARGS__) (__VA_ARGS__)
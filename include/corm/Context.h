@@ -1,7 +1,15 @@
 #ifndef CONTEXT_H_
 #define CONTEXT_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
+#include "AssemblyPlan.h"
 #include "Configuration.h"
 #include "CircularDependencyChecker.h"
 
@@ -10,10 +18,42 @@ namespace corm {
 /*
  * Assembler for configurations, that will allow any number of configurations to be registered, and allow
  * them all to be assembled.
+ *
+ * Assembly is event driven: each configuration keeps a count of the resources that it is still missing, and
+ * for each missing resource the context knows which configurations are waiting on it. Whenever a bean is
+ * registered, only the configurations waiting on that bean are updated, and those that are no longer missing
+ * anything are queued to be loaded. The assembly is therefore linear in the number of configurations plus the
+ * number of resources that they require.
+ *
+ * Optionally, the assembly can be performed by a number of threads, in which case all configurations which
+ * are ready are initialized at the same time (i.e.: independent configurations which take a long time to
+ * initialize do not hold each other up). The beans are registered thread-safely either way, however the
+ * configurations themselves must be safe to initialize alongside one another.
+ *
+ * The order in which the configurations were loaded can be saved as a plan (see AssemblyPlan). When the same
+ * configurations are registered again (i.e.: on the next start of the process), the plan can be loaded, in which
+ * case the configurations are loaded in that order directly, rather than first indexing the resources which each
+ * configuration is missing and loading the configurations as those become available. Each configuration still
+ * checks that its own resources are available before it is loaded.
+ *
+ * A context can be created as the child of an assembled context (see BeanManager), such as for the beans which are
+ * specific to a single request. The configurations of the child then only register their own beans, while resolving
+ * their resources from either context.
  */
 class Context: public BeanManager {
 
 public:
+	// CTOR of a context without parent
+	Context() = default;
+
+	/*
+	 * CTOR of a child context.
+	 *
+	 * @param parent BeanManager* pointer to the context (or manager) to fall back to for the beans which the child
+	 *        does not provide itself. It must outlive the child.
+	 */
+	explicit Context(BeanManager* parent);
+
 	// DTOR
 	virtual ~Context();
 
@@ -25,13 +65,21 @@ public:
 	 */
 	template<class Config>
 	void registerConfiguration() {
-		ConfigurationWrapper<Config>* c = new ConfigurationWrapper<Config>(this);
-		m_waitingConfigs.push_back(c);
+		registerConfiguration(new ConfigurationWrapper<Config>(this));
 
 		// Register any dependencies
 		Config::registerDependentConfigurations(this);
 	}
 
+	/*
+	 * Register a single configuration through its wrapper. Allows registering configurations which are only known at
+	 * runtime (i.e.: generated), rather than declared as a class.
+	 *
+	 * @param wrapper ConfigurationWrapperInterface* pointer to the wrapper of the configuration, which the context takes
+	 *        ownership of
+	 */
+	void registerConfiguration(ConfigurationWrapperInterface* wrapper);
+
 	/*
 	 * Register any number of configurations (minimum 1)
 	 *
@@ -47,19 +95,173 @@ public:
 	}
 
 	/*
-	 * Attempt to assemble all of the registered configurations.
+	 * Attempt to assemble all of the registered configurations. Once assembled, the context can be frozen
+	 * (see BeanManager::freeze) to speed up the retrieval of its beans.
 	 *
 	 * @throws ConfigurationInitializationException if the dependencies for all configurations cannot be fulfilled
+	 * @throws ConfigurationCycleException if the configurations cannot be fulfilled due to a cycle between them
 	 * @throws InvalidBeanTypeException if there is a bean type mismatch
 	 */
 	void assemble();
 
+	/*
+	 * Attempt to assemble all of the registered configurations, using the specified number of threads (including the
+	 * calling thread). Every configuration whose resources are satisfied is initialized right away on any idle thread.
+	 * Should the initialization of a configuration throw, no further configuration is started and the exception is
+	 * rethrown once the configurations that are already being initialized have completed.
+	 *
+	 * @param numThreads unsigned int the number of threads to assemble with (1 is equivalent to assemble())
+	 *
+	 * @throws ConfigurationInitializationException if the dependencies for all configurations cannot be fulfilled
+	 * @throws ConfigurationCycleException if the configurations cannot be fulfilled due to a cycle between them
+	 * @throws InvalidBeanTypeException if there is a bean type mismatch
+	 */
+	void assemble(unsigned int numThreads);
+
+	/*
+	 * Get how long the last assembly took, from start to finish (whether or not it succeeded).
+	 *
+	 * @return std::chrono::steady_clock::duration the duration of the last assembly
+	 */
+	std::chrono::steady_clock::duration getAssemblyTime() const;
+
+	/*
+	 * Save the plan of the last assembly to a file: the order in which the configurations were loaded.
+	 *
+	 * @param path const std::string& the file to write
+	 *
+	 * @return bool true if the plan was written, false if the file cannot be written or the context is not
+	 *         (fully) assembled
+	 */
+	bool saveAssemblyPlan(const std::string& path) const;
+
+	/*
+	 * Load the plan which the next assembly is to follow. The plan is only followed if it was made for the very
+	 * same configurations as are registered when assembling (otherwise, or if a configuration in the plan turns out
+	 * to be missing resources, the assembly proceeds as normal). The plan is followed on the calling thread only.
+	 *
+	 * @param path const std::string& the file to read
+	 *
+	 * @return bool true if the plan was read and matches the configurations registered thus far
+	 */
+	bool loadAssemblyPlan(const std::string& path);
+
+	/*
+	 * Get the number of configurations which were loaded by following the plan, during the last assembly.
+	 *
+	 * @return std::size_t the number of configurations
+	 */
+	std::size_t getNumPlannedConfigs() const;
+
+protected:
+	/*
+	 * Wake up the configurations which are waiting on the bean (if it is being assembled).
+	 *
+	 * @param name const std::string& the name of the bean that was registered
+	 */
+	virtual void beanRegistered(const std::string& name);
+
 private:
 	// vector of configurations which are still waiting to be processed
 	std::vector<ConfigurationWrapperInterface*> m_waitingConfigs;
 	// vector of configurations which are processed and active
 	std::vector<BaseConfiguration*> m_activeConfigs;
 
+	// Serializes the access to the assembly state below, as beans can be registered from any thread
+	std::mutex m_assemblyLock;
+	// A resource that at least one configuration is missing, as a slot of the open addressing (linear probing)
+	// table of missing resources. The name is copied into m_missingResourceNames, as the waiting resources of the
+	// configurations change while they are being loaded.
+	struct MissingResource {
+		// Where the name of the resource starts within m_missingResourceNames
+		std::size_t nameOffset;
+		// The length of the name of the resource, NO_NAME if the slot is empty
+		std::size_t nameLength;
+		// The first configuration waiting on the resource, NO_WAITER once the resource is registered
+		std::size_t firstWaiter;
+	};
+	// A configuration waiting on a resource. All waiters of a resource are chained together.
+	struct Waiter {
+		// The index of the configuration (within m_waitingConfigs)
+		std::size_t config;
+		// The next waiter of the same resource, or NO_WAITER
+		std::size_t next;
+	};
+	// Marks the end of a chain of waiters
+	static constexpr std::size_t NO_WAITER = SIZE_MAX;
+	// Marks an empty slot of the table of missing resources
+	static constexpr std::size_t NO_NAME = SIZE_MAX;
+
+	// The table of missing resources (the size of which is a power of two), empty when not assembling
+	std::vector<MissingResource> m_missingResources;
+	// The names of all missing resources, back to back
+	std::string m_missingResourceNames;
+	// All waiters, of all resources
+	std::vector<Waiter> m_waiters;
+	// For each configuration (by index within m_waitingConfigs), the number of resources it is still missing
+	std::vector<std::size_t> m_numMissingResources;
+	// The indices of the configurations that are ready to be loaded, in the order in which they became ready
+	std::vector<std::size_t> m_readyConfigs;
+	// The position within m_readyConfigs of the next configuration to load
+	std::size_t m_nextReadyConfig = 0;
+	// The number of configurations that are currently being loaded
+	std::size_t m_numLoadingConfigs = 0;
+	// Signalled whenever a configuration becomes ready, or finishes loading
+	std::condition_variable m_assemblyCondition;
+	// The duration of the last assembly
+	std::chrono::steady_clock::duration m_assemblyTime = std::chrono::steady_clock::duration::zero();
+
+	// The plan for the next assembly to follow (empty if none)
+	AssemblyPlan m_plan;
+	// The fingerprint of the configurations of the last assembly
+	std::uint64_t m_assemblyFingerprint = 0;
+	// The configurations loaded by the last assembly (by index within m_waitingConfigs), in the order of loading
+	std::vector<std::uint32_t> m_loadOrder;
+	// The number of configurations loaded by following the plan during the last assembly
+	std::size_t m_numPlannedConfigs = 0;
+
+	/*
+	 * Find the slot of the missing resource within the table, or the empty slot where it belongs.
+	 *
+	 * @param name std::string_view the name of the resource
+	 *
+	 * @return MissingResource& the slot
+	 */
+	MissingResource& findMissingResource(std::string_view name);
+
+	/*
+	 * Load the configurations in the order of the plan, until a configuration turns out to be missing resources.
+	 *
+	 * @param loaded std::vector<bool>& for each configuration (by index within m_waitingConfigs) whether it was loaded
+	 * @param failure std::exception_ptr& set to the exception thrown by the configuration which failed to load
+	 */
+	void followPlan(std::vector<bool>& loaded, std::exception_ptr& failure);
+
+	/*
+	 * Determine the resources that each waiting configuration (which is not yet loaded) is missing, and queue those
+	 * which are missing none.
+	 *
+	 * @param loaded const std::vector<bool>& for each configuration (by index within m_waitingConfigs) whether it was loaded
+	 */
+	void indexWaitingConfigs(const std::vector<bool>& loaded);
+
+	/*
+	 * Keep loading the configurations as they become ready, until either none remain which can become ready, or
+	 * the loading of a configuration fails. Can be called from any number of threads at the same time.
+	 *
+	 * @param loaded std::vector<bool>& for each configuration (by index within m_waitingConfigs) whether it was loaded
+	 * @param failure std::exception_ptr& set to the exception thrown by the first configuration which failed to load
+	 */
+	void loadReadyConfigs(std::vector<bool>& loaded, std::exception_ptr& failure);
+
+	/*
+	 * Stop tracking the resources, and clean up the configurations which were loaded. The remaining configurations
+	 * are updated to reflect which resources they are still waiting on.
+	 *
+	 * @param loaded const std::vector<bool>& for each configuration (by index within m_waitingConfigs) whether it was loaded
+	 */
+	void finishAssembly(const std::vector<bool>& loaded);
+
 	/*
 	 * Try to load the configuration that belongs to the wrapper.
 	 *
@@ -69,6 +271,13 @@ private:
 	 */
 	bool loadConfig(ConfigurationWrapperInterface* wrapper);
 
+	/*
+	 * Initialize the configuration, and keep it as active.
+	 *
+	 * @param config BaseConfiguration* pointer to the configuration, which is deleted if its initialization throws
+	 */
+	void initializeConfig(BaseConfiguration* config);
+
 	/*
 	 * Verify the context and make sure that everything is properly loaded.
 	 *
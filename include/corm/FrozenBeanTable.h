@@ -0,0 +1,167 @@
+#ifndef FROZENBEANTABLE_H_
+#define FROZENBEANTABLE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "BeanProvider.h"
+
+namespace corm {
+
+/*
+ * Immutable lookup table of bean providers, compiled from a fixed set of beans using a minimal perfect hash
+ * (hash and displace). The beans are spread over a number of buckets, and each bucket is assigned a seed such
+ * that every bean lands in its own slot, leaving no empty slot behind. A lookup is therefore always exactly:
+ *        * hashing the name once
+ *        * reading the seed of the bucket which the name falls in (the seeds take up 2 bytes per bean, so
+ *          typically remain cached)
+ *        * reading the single slot which the name maps to, and comparing it against the name
+ * without any probing, nor any allocation. Each slot fills exactly one cache line, holding the provider along
+ * with the name of the bean (only the part of a name which does not fit within the slot is stored separately),
+ * so that a lookup typically touches a single cache line beyond the seeds.
+ *
+ * Once built, the table cannot be modified, making it safe to look up from any number of threads.
+ */
+class FrozenBeanTable {
+
+public:
+	// A bean that is to be placed within the table
+	typedef std::pair<std::string_view, BaseProvider*> Bean;
+
+	/*
+	 * Build the table for the given beans.
+	 *
+	 * @param beans const std::vector<Bean>& the beans to place within the table, all of which must have a unique name
+	 *
+	 * @return FrozenBeanTable* pointer to the new table (owned by the caller), or NULL if no perfect hash could be
+	 *         found for the beans. This can only happen if two names have the very same 64 bit hash.
+	 */
+	static FrozenBeanTable* build(const std::vector<Bean>& beans);
+
+	// The table is shared by reference only
+	FrozenBeanTable(const FrozenBeanTable&) = delete;
+	FrozenBeanTable& operator=(const FrozenBeanTable&) = delete;
+
+	/*
+	 * Find the provider that is registered under the given name.
+	 *
+	 * @param name std::string_view the name of the bean
+	 *
+	 * @return BaseProvider* pointer to the provider, or NULL if no bean is registered under that name
+	 */
+	BaseProvider* find(std::string_view name) const {
+		const std::uint64_t h = hash(name);
+		const Slot& slot = m_slots[slotIndex(h, m_seeds[bucketIndex(h, m_numBuckets)], m_numSlots)];
+		if (slot.hash != h || slot.nameLength != name.size())
+			return NULL;
+		if (name.size() <= INLINE_NAME_LENGTH)
+			return name.compare(0, name.size(), slot.name, name.size()) == 0 ? slot.provider : NULL;
+		return name.compare(0, INLINE_NAME_LENGTH, slot.name, INLINE_NAME_LENGTH) == 0 &&
+				name.compare(INLINE_NAME_LENGTH, std::string_view::npos, m_overflow.data() + slot.overflowOffset,
+						name.size() - INLINE_NAME_LENGTH) == 0 ? slot.provider : NULL;
+	}
+
+	/*
+	 * Get the number of beans stored within the table.
+	 *
+	 * @return std::size_t the number of beans
+	 */
+	std::size_t size() const;
+
+private:
+	// The number of characters of a name which are stored directly within its slot
+	static constexpr std::size_t INLINE_NAME_LENGTH = 40;
+
+	// A single bean within the table, taking up one cache line
+	struct alignas(64) Slot {
+		std::uint64_t hash;
+		BaseProvider* provider;
+		std::uint32_t nameLength;
+		// Where the remainder of a name longer than INLINE_NAME_LENGTH is stored within m_overflow
+		std::uint32_t overflowOffset;
+		char name[INLINE_NAME_LENGTH];
+	};
+
+	// The number of buckets (i.e.: seeds)
+	std::size_t m_numBuckets = 0;
+	// The number of slots
+	std::size_t m_numSlots = 0;
+	// The seed of each bucket
+	std::vector<std::uint32_t> m_seeds;
+	// The beans, one per slot (an empty table has a single unused slot, so that a lookup never needs a check)
+	std::vector<Slot> m_slots;
+	// The remainder of all names which do not fit within their slot, back to back
+	std::string m_overflow;
+
+	// CTOR, to be used through build
+	FrozenBeanTable() = default;
+
+	/*
+	 * Try to find a seed for every bucket, placing the beans accordingly.
+	 *
+	 * @param beans const std::vector<Bean>& the beans to place
+	 * @param hashes const std::vector<std::uint64_t>& the hash of each bean
+	 * @param numBuckets std::size_t the number of buckets to spread the beans over
+	 *
+	 * @return bool true if all beans were placed
+	 */
+	bool place(const std::vector<Bean>& beans, const std::vector<std::uint64_t>& hashes, std::size_t numBuckets);
+
+	/*
+	 * Hash the name of a bean.
+	 *
+	 * @param name std::string_view the name to hash
+	 *
+	 * @return std::uint64_t the hash
+	 */
+	static std::uint64_t hash(std::string_view name) {
+		return std::hash<std::string_view>()(name);
+	}
+
+	/*
+	 * Map a value onto [0, range) through a multiplication rather than a (much slower) division.
+	 *
+	 * @param value std::uint32_t the value to map
+	 * @param range std::size_t the size of the range (less than 2^32)
+	 *
+	 * @return std::size_t the value within the range
+	 */
+	static std::size_t reduce(std::uint32_t value, std::size_t range) {
+		return (std::uint64_t(value) * range) >> 32;
+	}
+
+	/*
+	 * Get the bucket that the hash falls in.
+	 *
+	 * @param h std::uint64_t the hash of the name
+	 * @param numBuckets std::size_t the number of buckets
+	 *
+	 * @return std::size_t the index of the bucket
+	 */
+	static std::size_t bucketIndex(std::uint64_t h, std::size_t numBuckets) {
+		return reduce(std::uint32_t(h >> 32), numBuckets);
+	}
+
+	/*
+	 * Get the slot that the hash maps to for the seed, by remixing the hash with the seed.
+	 *
+	 * @param h std::uint64_t the hash of the name
+	 * @param seed std::uint32_t the seed of the bucket
+	 * @param numSlots std::size_t the number of slots
+	 *
+	 * @return std::size_t the index of the slot
+	 */
+	static std::size_t slotIndex(std::uint64_t h, std::uint32_t seed, std::size_t numSlots) {
+		// The name hash is already well mixed, so a single multiplication suffices to remix it
+		const std::uint64_t x = (h ^ (std::uint64_t(seed) * 0x9e3779b97f4a7c15ULL)) * 0xbf58476d1ce4e5b9ULL;
+		return reduce(std::uint32_t(x >> 32), numSlots);
+	}
+};
+
+}
+
+#endif /* FROZENBEANTABLE_H_ */
@@ -0,0 +1,186 @@
+#ifndef INTRUSIVEPTR_H_
+#define INTRUSIVEPTR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace corm {
+
+/*
+ * Reference count which can be shared between threads, changed through atomic operations.
+ */
+class AtomicRefCount {
+
+public:
+	void increment() {
+		m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/*
+	 * @return bool true if the count dropped to 0
+	 */
+	bool decrement() {
+		return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+	}
+
+	std::size_t get() const {
+		return m_count.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<std::size_t> m_count{0};
+};
+
+/*
+ * Reference count which is changed through plain (non-atomic) operations, and so is only to be used for beans which
+ * are never referenced from more than a single thread at a time.
+ */
+class LocalRefCount {
+
+public:
+	void increment() {
+		m_count++;
+	}
+
+	/*
+	 * @return bool true if the count dropped to 0
+	 */
+	bool decrement() {
+		return --m_count == 0;
+	}
+
+	std::size_t get() const {
+		return m_count;
+	}
+
+private:
+	std::size_t m_count = 0;
+};
+
+/*
+ * Base of a bean which counts its own references (see IntrusivePtr), so that the count lives within the bean itself
+ * rather than in a separate control block. The bean is destroyed when its last reference is released.
+ *
+ * @template T the type of the bean deriving from the RefCounted (which must be allocated with new)
+ * @template Count the reference count: AtomicRefCount (default) or LocalRefCount
+ */
+template<typename T, class Count = AtomicRefCount>
+class RefCounted {
+
+public:
+	void addRef() const {
+		m_refCount.increment();
+	}
+
+	void releaseRef() const {
+		if (m_refCount.decrement())
+			delete(static_cast<const T*>(this));
+	}
+
+	/*
+	 * Get the number of references to the bean.
+	 *
+	 * @return std::size_t the number of references
+	 */
+	std::size_t getRefCount() const {
+		return m_refCount.get();
+	}
+
+protected:
+	RefCounted() = default;
+	~RefCounted() = default;
+
+	// The count belongs to the instance, so it is never copied along with the rest of the bean
+	RefCounted(const RefCounted&) {}
+	RefCounted& operator=(const RefCounted&) {
+		return *this;
+	}
+
+private:
+	// The number of references to the bean
+	mutable Count m_refCount;
+};
+
+/*
+ * Smart pointer to a bean which counts its own references (such as a RefCounted), requiring no allocation beyond the
+ * bean itself. Can be used as the pointer of the SmartSingletonBeanCreator and the SmartFactoryBeanCreator, so that
+ * retrieving the bean only changes the count within the bean (which for a LocalRefCount is not even atomic).
+ *
+ * @template T the type of the bean, which must provide addRef() and releaseRef()
+ */
+template<typename T>
+class IntrusivePtr {
+
+public:
+	// CTOR of an empty pointer
+	IntrusivePtr() = default;
+
+	/*
+	 * CTOR
+	 *
+	 * @param bean T* pointer to the bean to reference (can be NULL)
+	 */
+	explicit IntrusivePtr(T* bean): m_bean(bean) {
+		if (m_bean != NULL)
+			m_bean->addRef();
+	}
+
+	// DTOR
+	~IntrusivePtr() {
+		if (m_bean != NULL)
+			m_bean->releaseRef();
+	}
+
+	IntrusivePtr(const IntrusivePtr& other): IntrusivePtr(other.m_bean) {}
+
+	IntrusivePtr(IntrusivePtr&& other) noexcept: m_bean(other.m_bean) {
+		other.m_bean = NULL;
+	}
+
+	IntrusivePtr& operator=(IntrusivePtr other) noexcept {
+		std::swap(m_bean, other.m_bean);
+		return *this;
+	}
+
+	/*
+	 * Release the reference (if any), and reference the specified bean instead.
+	 *
+	 * @param bean T* pointer to the bean to reference (can be NULL)
+	 */
+	void reset(T* bean = NULL) {
+		*this = IntrusivePtr(bean);
+	}
+
+	T* get() const {
+		return m_bean;
+	}
+
+	T* operator->() const {
+		return m_bean;
+	}
+
+	T& operator*() const {
+		return *m_bean;
+	}
+
+	explicit operator bool() const {
+		return m_bean != NULL;
+	}
+
+	bool operator==(const IntrusivePtr& other) const {
+		return m_bean == other.m_bean;
+	}
+
+	bool operator!=(const IntrusivePtr& other) const {
+		return m_bean != other.m_bean;
+	}
+
+private:
+	// The referenced bean (NULL if none)
+	T* m_bean = NULL;
+};
+
+}
+
+#endif /* INTRUSIVEPTR_H_ */
@@ -0,0 +1,21 @@
+#ifndef JSON_H_
+#define JSON_H_
+
+#include <ostream>
+#include <string_view>
+
+namespace corm {
+
+/*
+ * Write the string as a JSON string (surrounded by quotes), escaping the quotes, backslashes and control
+ * characters within it. Shared by everything which dumps JSON (the bean statistics, the trace, the benchmark
+ * report), rather than part of the public interface of CORM.
+ *
+ * @param os std::ostream& the stream to write to
+ * @param str std::string_view the string to write
+ */
+void writeJsonString(std::ostream& os, std::string_view str);
+
+}
+
+#endif /* JSON_H_ */
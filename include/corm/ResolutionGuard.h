@@ -0,0 +1,66 @@
+#ifndef RESOLUTIONGUARD_H_
+#define RESOLUTIONGUARD_H_
+
+#include <cstdint>
+#include <string_view>
+
+#include "BeanProvider.h"
+
+namespace corm {
+
+/*
+ * Helper which tracks that a bean is being retrieved by the current thread, for as long as the guard
+ * is in scope. Used to detect cycles when there is a chained situation ("getBean" calls from within
+ * the creation of another bean), regardless of whether the bean is retrieved through the BeanManager
+ * or through a BeanRef.
+ *
+ * The guards of a thread form a chain (each guard lives on the stack of the getBean call that created it),
+ * so tracking a bean requires no allocation nor any copy of its name. Alongside the chain, each thread keeps
+ * a set of "in progress" markers, where each provider maps to one of 64 marker bits. A bean can only be
+ * part of a cycle if its marker is set, so a lookup costs a single bit test. Only when the marker is set
+ * (a cycle, or another provider in the chain sharing the marker) is the chain walked to confirm.
+ */
+class ResolutionGuard {
+public:
+	/*
+	 * Start tracking the retrieval of the bean.
+	 *
+	 * @param provider const BaseProvider* the provider of the bean
+	 * @param name std::string_view the name of the bean, which must outlive the guard
+	 *
+	 * @throws BeanDependencyCycleException if the bean is already being retrieved by the current thread
+	 */
+	ResolutionGuard(const BaseProvider* provider, std::string_view name);
+	// DTOR which stops tracking the retrieval of the bean
+	~ResolutionGuard();
+
+	// The guard is tied to the scope in which it was created
+	ResolutionGuard(const ResolutionGuard&) = delete;
+	ResolutionGuard& operator=(const ResolutionGuard&) = delete;
+
+private:
+	// The innermost bean which the current thread is in the process of retrieving
+	static thread_local ResolutionGuard* s_current;
+	// The "in progress" markers of all beans which the current thread is in the process of retrieving
+	static thread_local std::uint64_t s_markers;
+
+	// The provider of the bean being retrieved
+	const BaseProvider* m_provider;
+	// The name of the bean being retrieved
+	std::string_view m_name;
+	// The guard of the bean whose retrieval triggered this one (NULL if none)
+	ResolutionGuard* m_parent;
+	// The "in progress" markers of the thread prior to this bean
+	std::uint64_t m_parentMarkers;
+
+	/*
+	 * Throw the exception for the cycle which the bean forms, reporting the full chain of beans.
+	 *
+	 * @throws BeanDependencyCycleException always
+	 */
+	[[noreturn]] void throwCycle() const;
+};
+
+}
+
+#endif /* RESOLUTIONGUARD_H_ */
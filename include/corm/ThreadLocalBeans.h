@@ -0,0 +1,96 @@
+#ifndef THREADLOCALBEANS_H_
+#define THREADLOCALBEANS_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace corm {
+
+/*
+ * The instances of a bean of which each thread has its own (see ThreadLocalBeanCreator). Each thread keeps the
+ * instances that it retrieved in a thread local table, so that finding the instance of the calling thread requires
+ * no synchronization at all. The instances are destroyed along with the thread which retrieved them, or else along
+ * with the ThreadLocalBeans (whichever ends first).
+ *
+ * Each ThreadLocalBeans is identified by an id which is never reused, so that a thread can never mistake a stale entry
+ * (of a ThreadLocalBeans which has since ended) for that of a new one.
+ */
+class ThreadLocalBeans {
+
+public:
+	/*
+	 * CTOR
+	 *
+	 * @param destroy void (*)(void*) destroys (and frees) an instance
+	 */
+	explicit ThreadLocalBeans(void (*destroy)(void*));
+
+	// DTOR which destroys the instances of all threads
+	~ThreadLocalBeans();
+
+	// The instances are tied to the id
+	ThreadLocalBeans(const ThreadLocalBeans&) = delete;
+	ThreadLocalBeans& operator=(const ThreadLocalBeans&) = delete;
+
+	/*
+	 * Find the instance of the calling thread.
+	 *
+	 * @return void* pointer to the instance, or NULL if the thread has none (yet)
+	 */
+	void* find() const;
+
+	/*
+	 * Keep the instance as that of the calling thread (which must not have one yet).
+	 *
+	 * @param instance void* pointer to the instance, which is destroyed along with the thread (or the ThreadLocalBeans).
+	 *        Should the instance not be kept (an exception is thrown), it remains up to the caller to destroy it.
+	 */
+	void insert(void* instance);
+
+	/*
+	 * Get the number of threads which have an instance.
+	 *
+	 * @return std::size_t the number of instances
+	 */
+	std::size_t size() const;
+
+private:
+	// The state shared between the ThreadLocalBeans and the threads with an instance
+	struct Shared {
+		// Guards the state
+		std::mutex lock;
+		// The instances which remain to be destroyed
+		std::vector<void*> instances;
+		// Whether the ThreadLocalBeans still exists
+		bool alive = true;
+		// Destroys an instance
+		void (*destroy)(void*);
+	};
+
+	// The instance of a thread
+	struct Slot {
+		std::uint64_t id;
+		void* instance;
+		std::shared_ptr<Shared> shared;
+	};
+
+	// The instances of a thread, destroying them when the thread ends
+	struct ThreadSlots {
+		std::vector<Slot> slots;
+		~ThreadSlots();
+	};
+
+	// The id of the ThreadLocalBeans
+	std::uint64_t m_id;
+	// The state shared with the threads
+	std::shared_ptr<Shared> m_shared;
+
+	// The instances of each thread
+	static thread_local ThreadSlots t_slots;
+};
+
+}
+
+#endif /* THREADLOCALBEANS_H_ */
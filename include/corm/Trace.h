@@ -0,0 +1,111 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <atomic>
+#include <string>
+
+namespace corm {
+
+/*
+ * Records a timeline of what CORM is doing (assembling the context, loading each configuration, creating each
+ * bean for the first time), which can be written as a Chrome Trace Event JSON file to be inspected through
+ * chrome://tracing or https://ui.perfetto.dev. Each event records the thread on which it took place.
+ *
+ * The instrumentation is only compiled in if ENABLE_CORM_TRACING is defined (-DENABLE_TRACING=ON with cmake),
+ * otherwise the CORM_TRACE_SCOPE macro expands to nothing at all. When compiled in, nothing is recorded until
+ * start is called, at a cost of a single (relaxed) atomic load per instrumented scope.
+ */
+class Trace {
+
+public:
+	/*
+	 * Start recording events, discarding any events recorded before.
+	 *
+	 * @param path const std::string& the file to write the events to when stopped
+	 */
+	static void start(const std::string& path);
+
+	/*
+	 * Stop recording events, and write all recorded events to the file.
+	 *
+	 * @return bool true if the file was written
+	 */
+	static bool stop();
+
+	/*
+	 * Check whether events are being recorded.
+	 *
+	 * @return bool true if recording
+	 */
+	static bool isEnabled() {
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	/*
+	 * Record the beginning of a scope on the calling thread.
+	 *
+	 * @param category const char* the category of the scope
+	 * @param name const std::string& the name of the scope
+	 */
+	static void begin(const char* category, const std::string& name);
+
+	/*
+	 * Record the end of the innermost scope on the calling thread.
+	 *
+	 * @param category const char* the category of the scope
+	 */
+	static void end(const char* category);
+
+private:
+	// Whether events are being recorded
+	static std::atomic<bool> s_enabled;
+};
+
+/*
+ * Records the beginning of a scope when created, and the end when destroyed. Use through CORM_TRACE_SCOPE.
+ */
+class TraceScope {
+
+public:
+	// CTOR
+	TraceScope(const char* category, const std::string& name): m_category(category), m_active(Trace::isEnabled()) {
+		if (m_active)
+			Trace::begin(category, name);
+	}
+
+	// DTOR
+	~TraceScope() {
+		if (m_active)
+			Trace::end(m_category);
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	// The category of the scope
+	const char* m_category;
+	// Whether the beginning of the scope was recorded (and therefore the end must be)
+	bool m_active;
+};
+
+}
+
+#define CORM_TRACE_CONCAT_IMPL(a, b) a##b
+#define CORM_TRACE_CONCAT(a, b) CORM_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_CORM_TRACING
+/*
+ * Trace the remainder of the enclosing scope. The name is only evaluated while recording.
+ *
+ * @param category const char* the category of the scope
+ * @param name the name of the scope (anything that a std::string can be constructed from)
+ */
+#define CORM_TRACE_SCOPE(category, name) \
+	corm::TraceScope CORM_TRACE_CONCAT(cormTraceScope, __LINE__)(category, \
+			corm::Trace::isEnabled() ? std::string(name) : std::string())
+#else
+#define CORM_TRACE_SCOPE(category, name) ((void)0)
+#endif
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,68 @@
+#ifndef TYPETAG_H_
+#define TYPETAG_H_
+
+#include <string>
+#include <string_view>
+
+namespace corm {
+
+/*
+ * Compile time generated tag which uniquely identifies a type, without relying on RTTI. Two tags are equal
+ * if and only if they were generated for the same type, making type checks a single pointer comparison.
+ */
+typedef const void* TypeTag;
+
+/*
+ * Holder of the static from which the tag for each type is generated. Each instantiation of the template
+ * has its own static, the address of which is the tag of that type.
+ *
+ * The static is deliberately not const. Identical read-only constants can be merged by the linker (identical
+ * code/data folding, such as lld --icf=all or MSVC /OPT:ICF), which would give different types the same tag,
+ * whereas writable data is never folded.
+ */
+template<typename T>
+struct TypeTagHolder {
+	static char m_id;
+};
+
+template<typename T>
+char TypeTagHolder<T>::m_id = 0;
+
+/*
+ * Get the tag of the type.
+ *
+ * @template T the type for which to get the tag
+ *
+ * @return TypeTag the tag of the type
+ */
+template<typename T>
+constexpr TypeTag typeTag() {
+	return &TypeTagHolder<T>::m_id;
+}
+
+/*
+ * Get the human readable name of the type, without relying on RTTI. Intended to be used purely for
+ * debugging and reporting purposes, as the exact format depends on the compiler.
+ *
+ * @template T the type for which to get the name
+ *
+ * @return std::string the name of the type
+ */
+template<typename T>
+std::string typeName() {
+#if defined(__GNUC__) || defined(__clang__)
+	// The signature is of the form "... typeName() [with T = Type; ...]" (GCC) or "... typeName() [T = Type]" (Clang)
+	std::string_view signature = __PRETTY_FUNCTION__;
+	std::size_t start = signature.find("T = ");
+	if (start != std::string_view::npos) {
+		start += 4;
+		std::size_t end = signature.find_first_of(";]", start);
+		return std::string(signature.substr(start, end - start));
+	}
+#endif
+	return "<unknown type>";
+}
+
+}
+
+#endif /* TYPETAG_H_ */
@@ -30,6 +30,24 @@ struct InvalidBeanTypeException: public std::runtime_error {
 	}
 };
 
+/*
+ * Exception which is to be thrown when attempting to register a bean after the manager has been frozen.
+ */
+struct BeanManagerFrozenException: public std::runtime_error {
+	BeanManagerFrozenException(const std::string name) :
+			std::runtime_error("Unable to register bean \"" + name + "\": the bean manager is frozen") {
+	}
+};
+
+/*
+ * Exception which is thrown when attempting to create a scoped bean while no BeanScope is active on the current thread.
+ */
+struct NoActiveBeanScopeException: public std::runtime_error {
+	NoActiveBeanScopeException() :
+			std::runtime_error("Unable to create scoped bean: no bean scope is active on the current thread") {
+	}
+};
+
 /*
  * Exception which is thrown when attempting to get a bean which exists within a dependency cycle (i.e.: BeanA depends on
  * BeanB, which depends on BeanA).
@@ -57,6 +75,7 @@ struct ConfigurationInitializationException: public std::runtime_error {
  */
 struct ConfigurationCycleException: public std::runtime_error {
 	ConfigurationCycleException(const std::vector<std::string>& cycle);
+	ConfigurationCycleException(const std::vector<std::vector<std::string>>& cycles);
 };
 
 }
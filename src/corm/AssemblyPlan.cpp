@@ -0,0 +1,212 @@
+#include "corm/AssemblyPlan.h"
+#include "corm/Configuration.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace corm {
+
+// Identifies a plan file
+static const char PLAN_MAGIC[8] = {'C', 'O', 'R', 'M', 'P', 'L', 'A', 'N'};
+// The version of the format of the file (and of the fingerprint)
+static const std::uint32_t PLAN_VERSION = 2;
+// The FNV-1a offset basis and prime, as the fingerprint must be the same regardless of std::hash
+static const std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+static const std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// CTOR
+AssemblyPlan::AssemblyPlan(std::uint64_t fingerprint, std::vector<std::uint32_t> loadOrder):
+		m_valid(true), m_fingerprint(fingerprint), m_loadOrder(std::move(loadOrder)) {
+}
+
+/*
+ * Add the bytes to the fingerprint.
+ *
+ * @param hash std::uint64_t& the fingerprint so far
+ * @param data const void* the bytes to add
+ * @param size std::size_t the number of bytes
+ */
+static void addToFingerprint(std::uint64_t& hash, const void* data, std::size_t size) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (std::size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * FNV_PRIME;
+}
+
+/*
+ * Add the string (including its length, so that "ab" + "c" differs from "a" + "bc") to the fingerprint.
+ *
+ * @param hash std::uint64_t& the fingerprint so far
+ * @param str const std::string& the string to add
+ */
+static void addToFingerprint(std::uint64_t& hash, const std::string& str) {
+	const std::uint64_t size = str.size();
+	addToFingerprint(hash, &size, sizeof(size));
+	addToFingerprint(hash, str.data(), str.size());
+}
+
+/*
+ * Add the strings (including their number) to the fingerprint.
+ *
+ * @param hash std::uint64_t& the fingerprint so far
+ * @param strs const std::vector<std::string>& the strings to add
+ */
+static void addToFingerprint(std::uint64_t& hash, const std::vector<std::string>& strs) {
+	const std::uint64_t size = strs.size();
+	addToFingerprint(hash, &size, sizeof(size));
+	for (const std::string& s: strs)
+		addToFingerprint(hash, s);
+}
+
+/*
+ * Hash everything that determines the order in which the configurations can be loaded
+ */
+std::uint64_t AssemblyPlan::fingerprint(const std::vector<ConfigurationWrapperInterface*>& configs) {
+	std::uint64_t hash = FNV_OFFSET;
+	const std::uint64_t numConfigs = configs.size();
+	addToFingerprint(hash, &PLAN_VERSION, sizeof(PLAN_VERSION));
+	addToFingerprint(hash, &numConfigs, sizeof(numConfigs));
+	for (ConfigurationWrapperInterface* c: configs) {
+		addToFingerprint(hash, c->getName());
+		addToFingerprint(hash, c->getWaitingResources());
+		addToFingerprint(hash, c->getBeanNames());
+	}
+	return hash;
+}
+
+/*
+ * Write the value as raw bytes.
+ *
+ * @param out std::ostream& the stream to write to
+ * @param value const T& the value to write
+ */
+template<typename T>
+static void writeValue(std::ostream& out, const T& value) {
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/*
+ * Write the plan
+ */
+bool AssemblyPlan::write(const std::string& path) const {
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(PLAN_MAGIC, sizeof(PLAN_MAGIC));
+	writeValue(out, PLAN_VERSION);
+	writeValue(out, m_fingerprint);
+	writeValue(out, std::uint32_t(m_loadOrder.size()));
+	for (std::uint32_t index: m_loadOrder)
+		writeValue(out, index);
+	out.close();
+	return bool(out);
+}
+
+/*
+ * Reader of the raw bytes of a plan, which is bounded by the size of the file such that a corrupt length can
+ * never cause more to be allocated than the file holds.
+ */
+class PlanReader {
+public:
+	// CTOR
+	PlanReader(const std::string& data): m_data(data) {}
+
+	/*
+	 * Read a value.
+	 *
+	 * @param value T& set to the value read
+	 *
+	 * @return bool true if there was enough data to read
+	 */
+	template<typename T>
+	bool readValue(T& value) {
+		if (m_data.size() - m_offset < sizeof(T))
+			return false;
+		std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+		m_offset += sizeof(T);
+		return true;
+	}
+
+	/*
+	 * Check whether the count of entries (each taking at least the given number of bytes) can fit in the rest of
+	 * the data.
+	 *
+	 * @param count std::uint32_t the number of entries
+	 * @param minSize std::size_t the minimum size of each entry
+	 *
+	 * @return bool true if they can fit
+	 */
+	bool canFit(std::uint32_t count, std::size_t minSize) const {
+		return count <= (m_data.size() - m_offset) / minSize;
+	}
+
+	/*
+	 * Check whether all of the data was read.
+	 *
+	 * @return bool true if at the end
+	 */
+	bool isAtEnd() const {
+		return m_offset == m_data.size();
+	}
+
+private:
+	// The data to read
+	const std::string& m_data;
+	// The offset within the data of the next byte to read
+	std::size_t m_offset = 0;
+};
+
+/*
+ * Read the whole file at once, and then parse it
+ */
+bool AssemblyPlan::read(const std::string& path) {
+	*this = AssemblyPlan();
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return false;
+	const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	PlanReader reader(data);
+	char magic[sizeof(PLAN_MAGIC)];
+	std::uint32_t version;
+	if (!reader.readValue(magic) || std::memcmp(magic, PLAN_MAGIC, sizeof(PLAN_MAGIC)) != 0 ||
+			!reader.readValue(version) || version != PLAN_VERSION)
+		return false;
+
+	AssemblyPlan plan;
+	std::uint32_t numConfigs;
+	if (!reader.readValue(plan.m_fingerprint) || !reader.readValue(numConfigs) || !reader.canFit(numConfigs, sizeof(std::uint32_t)))
+		return false;
+	plan.m_loadOrder.resize(numConfigs);
+	for (std::uint32_t& index: plan.m_loadOrder) {
+		if (!reader.readValue(index))
+			return false;
+	}
+	if (!reader.isAtEnd())
+		return false;
+
+	plan.m_valid = true;
+	*this = std::move(plan);
+	return true;
+}
+
+/*
+ * Check whether empty
+ */
+bool AssemblyPlan::isEmpty() const {
+	return !m_valid;
+}
+
+/*
+ * Get the fingerprint
+ */
+std::uint64_t AssemblyPlan::getFingerprint() const {
+	return m_fingerprint;
+}
+
+/*
+ * Get the load order
+ */
+const std::vector<std::uint32_t>& AssemblyPlan::getLoadOrder() const {
+	return m_loadOrder;
+}
+
+}
@@ -1,28 +1,100 @@
 #include "corm/BeanManager.h"
 
+#include <algorithm>
+
 namespace corm {
 
+// CTOR
+BeanManager::BeanManager(BeanManager* parent): m_parent(parent) {}
+
 // DTOR
 BeanManager::~BeanManager() {
-	for (std::pair<std::string, BaseProvider*> i: m_repo)
-		delete(i.second);
+	m_repo.forEach([](const std::string&, BaseProvider* provider) { delete(provider); });
 }
 
 /*
  * Check whether or not the bean already exists
  */
-bool BeanManager::containsBean(std::string name) {
-	return m_repo.count(name);
+bool BeanManager::containsBean(std::string_view name) {
+	return findProvider(name) != NULL;
+}
+
+/*
+ * Get the parent
+ */
+BeanManager* BeanManager::getParent() const {
+	return m_parent;
 }
 
 /*
  * Verify that the bean can be added, throwing an exception otherwise.
  */
-void BeanManager::verifyCanAddBean(std::string name) {
+void BeanManager::verifyCanAddBean(std::string_view name) {
 	if (name.empty())
-		throw InvalidBeanNameException(name, "bean name cannot be empty");
+		throw InvalidBeanNameException(std::string(name), "bean name cannot be empty");
+	else if (isFrozen())
+		throw BeanManagerFrozenException(std::string(name));
 	else if (containsBean(name))
+		throw InvalidBeanNameException(std::string(name), "bean is already registered");
+}
+
+/*
+ * Add the provider, making sure that it is not leaked if the name was taken in the meantime
+ */
+void BeanManager::addProvider(std::string&& name, BaseProvider* provider) {
+	const std::string* registeredName = m_repo.insert(std::move(name), provider);
+	if (registeredName == NULL) {
+		delete(provider);
+		// The name is only moved from if the provider was inserted
+		if (isFrozen())
+			throw BeanManagerFrozenException(name);
 		throw InvalidBeanNameException(name, "bean is already registered");
+	}
+
+	beanRegistered(*registeredName);
 }
 
+/*
+ * Collect the statistics of all beans
+ */
+std::vector<BeanStatisticsEntry> BeanManager::getStatistics() const {
+	std::vector<BeanStatisticsEntry> statistics;
+	m_repo.forEach([&statistics](const std::string& name, BaseProvider* provider) {
+		BeanStatisticsEntry entry{name, provider->getType(), 0, 0, 0, std::chrono::nanoseconds::zero()};
+#ifndef DISABLE_CORM_STATISTICS
+		if (const BeanStatistics* s = provider->getStatistics()) {
+			entry.lookups = s->getLookups();
+			entry.typeMismatches = s->getTypeMismatches();
+			entry.creations = s->getCreations();
+			entry.creationTime = s->getCreationTime();
+		}
+#endif
+		statistics.push_back(std::move(entry));
+	});
+
+	std::sort(statistics.begin(), statistics.end(), [](const BeanStatisticsEntry& l, const BeanStatisticsEntry& r) {
+		return l.name < r.name;
+	});
+	return statistics;
+}
+
+/*
+ * Freeze the repository
+ */
+void BeanManager::freeze() {
+	m_repo.freeze();
+}
+
+/*
+ * Check whether the repository is frozen
+ */
+bool BeanManager::isFrozen() const {
+	return m_repo.isFrozen();
+}
+
+/*
+ * Nothing to do by default
+ */
+void BeanManager::beanRegistered(const std::string& name) {}
+
 }
@@ -0,0 +1,149 @@
+#include "corm/BeanRegistry.h"
+
+#include <functional>
+
+namespace corm {
+
+// The size of the table when the first bean is inserted
+static const std::size_t INITIAL_CAPACITY = 16;
+
+// CTOR
+BeanRegistry::Table::Table(std::size_t capacity): mask(capacity - 1), slots(new std::atomic<const Entry*>[capacity]) {
+	for (std::size_t i = 0; i < capacity; i++)
+		slots[i].store(NULL, std::memory_order_relaxed);
+}
+
+// DTOR
+BeanRegistry::~BeanRegistry() {
+	// The entries are shared between all of the tables, so only the current table is used to clean them up
+	const Table* table = m_table.load(std::memory_order_acquire);
+	if (table == NULL)
+		return;
+
+	for (std::size_t i = 0; i <= table->mask; i++)
+		delete(table->slots[i].load(std::memory_order_relaxed));
+}
+
+/*
+ * Find the provider through a single probe sequence
+ */
+BaseProvider* BeanRegistry::findInTable(std::string_view name) const {
+	const Table* table = m_table.load(std::memory_order_acquire);
+	if (table == NULL)
+		return NULL;
+
+	const std::size_t h = hash(name);
+	for (std::size_t i = h & table->mask;; i = (i + 1) & table->mask) {
+		const Entry* entry = table->slots[i].load(std::memory_order_acquire);
+		if (entry == NULL)
+			return NULL;
+		if (entry->hash == h && entry->name == name)
+			return entry->provider;
+	}
+}
+
+/*
+ * Insert the provider, unless the name is already taken
+ */
+const std::string* BeanRegistry::insert(std::string&& name, BaseProvider* provider) {
+	const std::size_t h = hash(name);
+	std::lock_guard<std::mutex> lock(m_writeLock);
+	if (m_frozen.load(std::memory_order_relaxed))
+		return NULL;
+
+	// Keep the load factor at or below 1/2 so that probe sequences remain short
+	Table* table = const_cast<Table*>(m_table.load(std::memory_order_relaxed));
+	const std::size_t size = m_size.load(std::memory_order_relaxed);
+	if (table == NULL || (size + 1) * 2 > table->mask + 1)
+		table = grow();
+
+	std::size_t i = h & table->mask;
+	for (const Entry* entry; (entry = table->slots[i].load(std::memory_order_relaxed)) != NULL; i = (i + 1) & table->mask) {
+		if (entry->hash == h && entry->name == name)
+			return NULL;
+	}
+
+	// Publish the fully built entry
+	const Entry* entry = new Entry{h, std::move(name), provider};
+#ifdef ENABLE_CORM_TRACING
+	provider->setTraceName(&entry->name);
+#endif
+	table->slots[i].store(entry, std::memory_order_release);
+	m_size.store(size + 1, std::memory_order_relaxed);
+	return &entry->name;
+}
+
+/*
+ * Compile the beans into the frozen table
+ */
+void BeanRegistry::freeze() {
+	std::lock_guard<std::mutex> lock(m_writeLock);
+	if (m_frozen.load(std::memory_order_relaxed))
+		return;
+	m_frozen.store(true, std::memory_order_release);
+
+	std::vector<FrozenBeanTable::Bean> beans;
+	beans.reserve(m_size.load(std::memory_order_relaxed));
+	const Table* table = m_table.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; table != NULL && i <= table->mask; i++) {
+		const Entry* entry = table->slots[i].load(std::memory_order_relaxed);
+		if (entry != NULL)
+			beans.emplace_back(entry->name, entry->provider);
+	}
+
+	// Should no perfect hash exist for the names (which is astronomically unlikely), lookups simply remain on
+	// the open addressing table, which is no longer modified either way.
+	m_frozenTableOwner.reset(FrozenBeanTable::build(beans));
+	m_frozenTable.store(m_frozenTableOwner.get(), std::memory_order_release);
+}
+
+/*
+ * Check whether frozen
+ */
+bool BeanRegistry::isFrozen() const {
+	return m_frozen.load(std::memory_order_acquire);
+}
+
+/*
+ * Get the number of beans
+ */
+std::size_t BeanRegistry::size() const {
+	return m_size.load(std::memory_order_relaxed);
+}
+
+/*
+ * Hash the name
+ */
+std::size_t BeanRegistry::hash(std::string_view name) {
+	return std::hash<std::string_view>()(name);
+}
+
+/*
+ * Grow the table
+ */
+BeanRegistry::Table* BeanRegistry::grow() {
+	const Table* old = m_table.load(std::memory_order_relaxed);
+	m_tables.emplace_back(new Table(old == NULL ? INITIAL_CAPACITY : (old->mask + 1) * 2));
+	Table* table = m_tables.back().get();
+
+	// Carry all of the existing entries over to the new table. The names are known to be unique, so there is no
+	// need to compare them.
+	if (old != NULL) {
+		for (std::size_t o = 0; o <= old->mask; o++) {
+			const Entry* entry = old->slots[o].load(std::memory_order_relaxed);
+			if (entry == NULL)
+				continue;
+
+			std::size_t i = entry->hash & table->mask;
+			while (table->slots[i].load(std::memory_order_relaxed) != NULL)
+				i = (i + 1) & table->mask;
+			table->slots[i].store(entry, std::memory_order_relaxed);
+		}
+	}
+
+	// Only publish the new table once it is complete
+	m_table.store(table, std::memory_order_release);
+	return table;
+}
+
+}
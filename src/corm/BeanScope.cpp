@@ -0,0 +1,54 @@
+#include "corm/BeanScope.h"
+
+namespace corm {
+
+// The innermost active scope of each thread
+thread_local BeanScope* BeanScope::s_current = NULL;
+
+// CTOR
+BeanScope::BeanScope(): m_arena(m_initialArena, sizeof(m_initialArena)), m_previous(s_current) {
+	s_current = this;
+}
+
+// DTOR
+BeanScope::~BeanScope() {
+	reset();
+	s_current = m_previous;
+}
+
+/*
+ * Get the innermost scope
+ */
+BeanScope* BeanScope::current() {
+	return s_current;
+}
+
+/*
+ * Get the innermost scope, which must exist
+ */
+BeanScope& BeanScope::requireCurrent() {
+	if (s_current == NULL)
+		throw NoActiveBeanScopeException();
+	return *s_current;
+}
+
+/*
+ * Destroy the beans (most recent first), then rewind the arena to its start
+ */
+void BeanScope::reset() {
+	for (Cleanup* c = m_cleanups; c != NULL; c = c->next)
+		c->destroy(c->bean);
+	m_cleanups = NULL;
+	m_instances = NULL;
+	m_numBeans = 0;
+	m_arena.release();
+}
+
+/*
+ * Get the number of beans
+ */
+std::size_t BeanScope::size() const {
+	return m_numBeans;
+}
+
+}
@@ -0,0 +1,70 @@
+#include "corm/BeanStatistics.h"
+#include "corm/Json.h"
+
+namespace corm {
+
+std::atomic<bool> BeanStatistics::s_enabled(false);
+
+/*
+ * Toggle the counting
+ */
+void BeanStatistics::setEnabled(bool enabled) {
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/*
+ * Get the lookups
+ */
+std::uint64_t BeanStatistics::getLookups() const {
+	return m_lookups.load(std::memory_order_relaxed);
+}
+
+/*
+ * Get the type mismatches
+ */
+std::uint64_t BeanStatistics::getTypeMismatches() const {
+	return m_typeMismatches.load(std::memory_order_relaxed);
+}
+
+/*
+ * Get the creations
+ */
+std::uint64_t BeanStatistics::getCreations() const {
+	return m_creations.load(std::memory_order_relaxed);
+}
+
+/*
+ * Get the creation time
+ */
+std::chrono::nanoseconds BeanStatistics::getCreationTime() const {
+	return std::chrono::nanoseconds(m_creationTime.load(std::memory_order_relaxed));
+}
+
+/*
+ * Write one line per bean
+ */
+void writeStatisticsText(std::ostream& os, const std::vector<BeanStatisticsEntry>& statistics) {
+	for (const BeanStatisticsEntry& e: statistics) {
+		os << e.name << " (" << e.type << "): lookups=" << e.lookups << " typeMismatches=" << e.typeMismatches
+				<< " creations=" << e.creations << " creationTime=" << e.creationTime.count() << "ns\n";
+	}
+}
+
+/*
+ * Write all beans as JSON
+ */
+void writeStatisticsJson(std::ostream& os, const std::vector<BeanStatisticsEntry>& statistics) {
+	os << "{\"beans\": [";
+	for (std::size_t i = 0; i < statistics.size(); i++) {
+		const BeanStatisticsEntry& e = statistics[i];
+		os << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+		writeJsonString(os, e.name);
+		os << ", \"type\": ";
+		writeJsonString(os, e.type);
+		os << ", \"lookups\": " << e.lookups << ", \"typeMismatches\": " << e.typeMismatches << ", \"creations\": "
+				<< e.creations << ", \"creationTimeNs\": " << e.creationTime.count() << "}";
+	}
+	os << "\n]}\n";
+}
+
+}
@@ -1,5 +1,5 @@
 #include "corm/CircularDependencyChecker.h"
-#include <iostream>
+
 #include <algorithm>
 
 namespace corm {
@@ -9,84 +9,183 @@ namespace corm {
  */
 void CircularDependencyChecker::add(std::string name, std::vector<std::string> resources,
 		std::vector<std::string> beans) {
-	m_configResources[name] = resources;
-	for(std::string s: beans)
-		m_beanSource[s] = name;
+	std::pair<std::unordered_map<std::string, std::size_t>::iterator, bool> inserted =
+			m_configIds.emplace(name, m_configNames.size());
+	const std::size_t id = inserted.first->second;
+	if (inserted.second) {
+		m_configNames.push_back(std::move(name));
+		m_configResources.push_back(std::move(resources));
+	} else {
+		m_configResources[id] = std::move(resources);
+	}
+
+	for (std::string& s: beans)
+		m_beanSource[std::move(s)] = id;
 }
 
 /*
  * Check whether a cycle is present
  */
 bool CircularDependencyChecker::checkForCycle() {
-	// Iterate over each configuration
-	for (std::pair<std::string,  std::vector<std::string>> p: m_configResources) {
-		// Check each configuration to see whether or not it is part of a cycle.
-		if (checkAllResources(p.first)) {
-			minimizeCycle();
-			return true;
+	m_cycles.clear();
+	buildDependencies();
+	const std::vector<std::size_t> components = findComponents();
+
+	// Look for a cycle within each component, starting from the first added configuration within it. A component
+	// of a single configuration only contains a cycle if the configuration depends on itself.
+	std::vector<bool> checked(m_configNames.size(), false);
+	std::vector<std::size_t> reachedThrough(m_configNames.size(), NOT_REACHED);
+	for (std::size_t c = 0; c < m_configNames.size(); c++) {
+		if (!checked[components[c]]) {
+			checked[components[c]] = true;
+			recordCycle(c, components, reachedThrough);
 		}
 	}
 
-	return false;
+	return !m_cycles.empty();
 }
 
 /*
- * Minimize the reported cycle the smallest it can be.
+ * Get the first detected cycle.
  */
-void CircularDependencyChecker::minimizeCycle() {
-	auto start = std::find(m_cycle.begin(), m_cycle.end(), m_cycle[m_cycle.size() - 1]);
-	m_cycle.erase(m_cycle.begin(), start);
+const std::vector<std::string>& CircularDependencyChecker::getCycle() {
+	static const std::vector<std::string> noCycle;
+	return m_cycles.empty() ? noCycle : m_cycles.front();
 }
 
 /*
- * Get the detected cycle.
+ * Get all detected cycles.
  */
-const std::vector<std::string>& CircularDependencyChecker::getCycle() {
-	return m_cycle;
+const std::vector<std::vector<std::string>>& CircularDependencyChecker::getCycles() {
+	return m_cycles;
+}
+
+/*
+ * Build the dependencies from the providers of the resources
+ */
+void CircularDependencyChecker::buildDependencies() {
+	m_dependencies.clear();
+	m_firstDependency.assign(m_configNames.size() + 1, 0);
+	for (std::size_t c = 0; c < m_configNames.size(); c++) {
+		m_firstDependency[c] = m_dependencies.size();
+		const std::vector<std::string>& resources = m_configResources[c];
+		for (std::size_t r = 0; r < resources.size(); r++) {
+			// A resource without a (known) provider cannot be party to a cycle
+			std::unordered_map<std::string, std::size_t>::const_iterator source = m_beanSource.find(resources[r]);
+			if (source != m_beanSource.end())
+				m_dependencies.push_back(Dependency{c, source->second, r});
+		}
+	}
+	m_firstDependency[m_configNames.size()] = m_dependencies.size();
 }
 
 /*
- * Check all resources for the given configuration
+ * Tarjan's algorithm, with an explicit stack in place of the recursion so that deep chains of configurations
+ * cannot overflow the stack.
  */
-bool CircularDependencyChecker::checkAllResources(std::string configName) {
-	// Sanity check, make sure that this configuration has been registered
-	if (!m_configResources.count(configName))
-		return false;
-
-	// Check all of the resources that the configuration requires
-	std::vector<std::string>& resources = m_configResources[configName];
-	for (std::string res: resources) {
-		// Check if a cycle was found
-		if (followResource(configName, res))
-			return true;
+std::vector<std::size_t> CircularDependencyChecker::findComponents() const {
+	const std::size_t numConfigs = m_configNames.size();
+	std::vector<std::size_t> order(numConfigs, NOT_REACHED);
+	std::vector<std::size_t> lowLink(numConfigs, 0);
+	std::vector<std::size_t> components(numConfigs, NOT_REACHED);
+	std::vector<bool> onStack(numConfigs, false);
+	// Configurations which were reached, but not yet assigned to a component
+	std::vector<std::size_t> stack;
+	// Configurations being visited, along with the next of its dependencies to follow
+	std::vector<std::pair<std::size_t, std::size_t>> visiting;
+	std::size_t nextOrder = 0;
+	std::size_t numComponents = 0;
+
+	for (std::size_t root = 0; root < numConfigs; root++) {
+		if (order[root] != NOT_REACHED)
+			continue;
+
+		order[root] = lowLink[root] = nextOrder++;
+		stack.push_back(root);
+		onStack[root] = true;
+		visiting.emplace_back(root, m_firstDependency[root]);
+
+		while (!visiting.empty()) {
+			const std::size_t c = visiting.back().first;
+			const std::size_t d = visiting.back().second;
+			if (d < m_firstDependency[c + 1]) {
+				// Follow the next dependency
+				visiting.back().second++;
+				const std::size_t provider = m_dependencies[d].provider;
+				if (order[provider] == NOT_REACHED) {
+					order[provider] = lowLink[provider] = nextOrder++;
+					stack.push_back(provider);
+					onStack[provider] = true;
+					visiting.emplace_back(provider, m_firstDependency[provider]);
+				} else if (onStack[provider]) {
+					lowLink[c] = std::min(lowLink[c], order[provider]);
+				}
+				continue;
+			}
+
+			// All dependencies followed, if this is the root of a component then everything above it on the stack
+			// belongs to the component
+			visiting.pop_back();
+			if (lowLink[c] == order[c]) {
+				std::size_t member;
+				do {
+					member = stack.back();
+					stack.pop_back();
+					onStack[member] = false;
+					components[member] = numComponents;
+				} while (member != c);
+				numComponents++;
+			}
+
+			if (!visiting.empty()) {
+				const std::size_t parent = visiting.back().first;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[c]);
+			}
+		}
 	}
 
-	// No cycle was found!
-	return false;
+	return components;
 }
 
 /*
- * Follow the resource required by the configuration, and see whether a cycle is present.
+ * Breadth first search from the configuration back to itself
  */
-bool CircularDependencyChecker::followResource(std::string configName, std::string resourceName) {
-	// Build the display name and check if it has been seen.
-	std::string compoundName = configName + "::" + resourceName;
-	bool hasCycle = std::find(m_cycle.begin(), m_cycle.end(), compoundName) != m_cycle.end();
-	m_cycle.push_back(compoundName);
-
-	// Check if a cycle has been detected (the display name is already present in the vector
-	if (hasCycle)
-		return true;
-
-	// Follow the source of the resource
-	if (m_beanSource.count(resourceName)) {
-		if (checkAllResources(m_beanSource[resourceName]))
-			return true;
+void CircularDependencyChecker::recordCycle(std::size_t start, const std::vector<std::size_t>& components,
+		std::vector<std::size_t>& reachedThrough) {
+	std::vector<std::size_t> queue(1, start);
+	std::size_t closingDependency = NOT_REACHED;
+	for (std::size_t head = 0; head < queue.size() && closingDependency == NOT_REACHED; head++) {
+		const std::size_t c = queue[head];
+		for (std::size_t d = m_firstDependency[c]; d < m_firstDependency[c + 1]; d++) {
+			const std::size_t provider = m_dependencies[d].provider;
+			if (provider == start) {
+				closingDependency = d;
+				break;
+			} else if (components[provider] == components[start] && reachedThrough[provider] == NOT_REACHED) {
+				reachedThrough[provider] = d;
+				queue.push_back(provider);
+			}
+		}
+	}
+
+	if (closingDependency != NOT_REACHED) {
+		// Walk the path back to the start, and report it from the start onwards (ending where it started)
+		std::vector<std::string> cycle;
+		for (std::size_t d = closingDependency;; d = reachedThrough[m_dependencies[d].dependent]) {
+			const Dependency& dependency = m_dependencies[d];
+			cycle.push_back(m_configNames[dependency.dependent] + "::" +
+					m_configResources[dependency.dependent][dependency.resource]);
+			if (dependency.dependent == start)
+				break;
+		}
+		std::reverse(cycle.begin(), cycle.end());
+		cycle.push_back(cycle.front());
+		m_cycles.push_back(std::move(cycle));
 	}
 
-	// No cycle detected
-	m_cycle.pop_back();
-	return false;
+	// Leave the scratch space clean for the next search
+	for (std::size_t c: queue)
+		reachedThrough[c] = NOT_REACHED;
 }
 
 }
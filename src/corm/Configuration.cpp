@@ -1,4 +1,5 @@
 #include "corm/Configuration.h"
+#include "corm/Trace.h"
 
 namespace corm {
 
@@ -32,8 +33,14 @@ const std::vector<std::string>& BaseConfiguration::getBeanNames() {
  * Initialize the configuration
  */
 void BaseConfiguration::initialize() {
-	postInit();
-	provideBeans();
+	{
+		CORM_TRACE_SCOPE("configuration", "postInit");
+		postInit();
+	}
+	{
+		CORM_TRACE_SCOPE("configuration", "provideBeans");
+		provideBeans();
+	}
 }
 
 /*
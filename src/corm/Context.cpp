@@ -1,7 +1,14 @@
 #include "corm/Context.h"
+#include "corm/Trace.h"
+
+#include <system_error>
+#include <thread>
 
 namespace corm {
 
+// CTOR
+Context::Context(BeanManager* parent): BeanManager(parent) {}
+
 // DTOR
 Context::~Context() {
 	// Cleanup the configs which are still waiting
@@ -14,44 +21,290 @@ Context::~Context() {
 }
 
 /*
- * Assemble the context
+ * Add the wrapper to the configurations waiting to be assembled
+ */
+void Context::registerConfiguration(ConfigurationWrapperInterface* wrapper) {
+	m_waitingConfigs.push_back(wrapper);
+}
+
+/*
+ * Assemble the context on the calling thread only
  */
 void Context::assemble() {
-	// So long as configs are being processed, keep going. Extremely simplistic mechanism for
-	// processing the dependencies across multiple configs.
-	bool configProcessed = false;
-	do {
-		configProcessed = false;
-
-		// Iterate through all registered configs and try to build and initialize them
-		std::vector<ConfigurationWrapperInterface*>::iterator it = m_waitingConfigs.begin();
-		while (it != m_waitingConfigs.end()) {
-			// Try to load the configuration
-			if (loadConfig(*it)) {
-				// Success! Clean up the wrapper for the loaded config
-				configProcessed = true;
-				delete(*it);
-				it = m_waitingConfigs.erase(it);
-			} else
-				++it;
+	assemble(1);
+}
+
+/*
+ * Assemble the context
+ */
+void Context::assemble(unsigned int numThreads) {
+	CORM_TRACE_SCOPE("context", "assemble");
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<bool> loaded(m_waitingConfigs.size(), false);
+	std::exception_ptr failure;
+	m_assemblyFingerprint = AssemblyPlan::fingerprint(m_waitingConfigs);
+	m_loadOrder.clear();
+	m_numPlannedConfigs = 0;
+
+	// A plan only applies to the assembly that immediately follows
+	if (!m_plan.isEmpty() && m_plan.getFingerprint() == m_assemblyFingerprint)
+		followPlan(loaded, failure);
+	m_plan = AssemblyPlan();
 
+	// Load the (remaining) configurations as they become ready. Loading a configuration registers its beans, which
+	// in turn queues any configuration that was only waiting on those beans.
+	indexWaitingConfigs(loaded);
+	std::vector<std::thread> helpers;
+	for (unsigned int i = 1; i < numThreads; i++) {
+		try {
+			helpers.emplace_back(&Context::loadReadyConfigs, this, std::ref(loaded), std::ref(failure));
+		} catch (std::system_error&) {
+			// Make do with the threads that could be started
+			break;
 		}
-	} while(configProcessed);
+	}
+	loadReadyConfigs(loaded, failure);
+	for (std::thread& t: helpers)
+		t.join();
+
+	finishAssembly(loaded);
+	m_assemblyTime = std::chrono::steady_clock::now() - start;
+	if (failure)
+		std::rethrow_exception(failure);
 
 	// Ensure the sanity of the context
 	verifyContext();
 }
 
+/*
+ * Get the duration of the last assembly
+ */
+std::chrono::steady_clock::duration Context::getAssemblyTime() const {
+	return m_assemblyTime;
+}
+
+/*
+ * Save the plan of the last assembly
+ */
+bool Context::saveAssemblyPlan(const std::string& path) const {
+	if (!m_waitingConfigs.empty())
+		return false;
+	return AssemblyPlan(m_assemblyFingerprint, m_loadOrder).write(path);
+}
+
+/*
+ * Load the plan for the next assembly
+ */
+bool Context::loadAssemblyPlan(const std::string& path) {
+	if (!m_plan.read(path))
+		return false;
+	return m_plan.getFingerprint() == AssemblyPlan::fingerprint(m_waitingConfigs);
+}
+
+/*
+ * Get the number of configurations loaded through the plan
+ */
+std::size_t Context::getNumPlannedConfigs() const {
+	return m_numPlannedConfigs;
+}
+
+/*
+ * Follow the plan, building each configuration in turn without indexing the resources which it is missing (building
+ * a configuration only checks that its resources are available). Should a configuration turn out to be missing
+ * resources after all (i.e.: a bean that it depends on is no longer registered externally), the remainder of the plan
+ * is abandoned.
+ */
+void Context::followPlan(std::vector<bool>& loaded, std::exception_ptr& failure) {
+	CORM_TRACE_SCOPE("context", "followPlan");
+	for (std::uint32_t index: m_plan.getLoadOrder()) {
+		if (index >= m_waitingConfigs.size() || loaded[index])
+			return;
+
+		ConfigurationWrapperInterface* wrapper = m_waitingConfigs[index];
+		try {
+			CORM_TRACE_SCOPE("configuration", wrapper->getName());
+			BaseConfiguration* config;
+			try {
+				config = wrapper->buildConfig();
+			} catch (ConfigurationMissingResourcesException&) {
+				return;
+			}
+			initializeConfig(config);
+		} catch (...) {
+			failure = std::current_exception();
+			return;
+		}
+
+		loaded[index] = true;
+		m_loadOrder.push_back(index);
+		m_numPlannedConfigs++;
+	}
+}
+
+/*
+ * Index the resources which are missing
+ */
+void Context::indexWaitingConfigs(const std::vector<bool>& loaded) {
+	std::lock_guard<std::mutex> lock(m_assemblyLock);
+
+	// Size the table for the case where every resource is missing, keeping the load factor at or below 1/2
+	std::size_t numResources = 0;
+	for (std::size_t i = 0; i < m_waitingConfigs.size(); i++) {
+		if (!loaded[i])
+			numResources += m_waitingConfigs[i]->getWaitingResources().size();
+	}
+	std::size_t capacity = 1;
+	while (capacity < numResources * 2)
+		capacity *= 2;
+
+	m_missingResources.assign(capacity, MissingResource{0, NO_NAME, NO_WAITER});
+	m_waiters.reserve(numResources);
+	m_numMissingResources.assign(m_waitingConfigs.size(), 0);
+	m_readyConfigs.reserve(m_waitingConfigs.size());
+	for (std::size_t i = 0; i < m_waitingConfigs.size(); i++) {
+		if (loaded[i])
+			continue;
+		for (const std::string& resource: m_waitingConfigs[i]->getWaitingResources()) {
+			if (!containsBean(resource)) {
+				MissingResource& missing = findMissingResource(resource);
+				if (missing.nameLength == NO_NAME) {
+					missing.nameOffset = m_missingResourceNames.size();
+					missing.nameLength = resource.size();
+					m_missingResourceNames.append(resource);
+				}
+				m_waiters.push_back(Waiter{i, missing.firstWaiter});
+				missing.firstWaiter = m_waiters.size() - 1;
+				m_numMissingResources[i]++;
+			}
+		}
+
+		if (m_numMissingResources[i] == 0)
+			m_readyConfigs.push_back(i);
+	}
+}
+
+/*
+ * Linear probing for the resource
+ */
+Context::MissingResource& Context::findMissingResource(std::string_view name) {
+	const std::size_t mask = m_missingResources.size() - 1;
+	for (std::size_t i = std::hash<std::string_view>()(name) & mask;; i = (i + 1) & mask) {
+		MissingResource& missing = m_missingResources[i];
+		if (missing.nameLength == NO_NAME || (missing.nameLength == name.size() &&
+				name.compare(0, name.size(), m_missingResourceNames.data() + missing.nameOffset, missing.nameLength) == 0))
+			return missing;
+	}
+}
+
+/*
+ * Load the ready configurations. All of the assembly state is only accessed while holding the lock, which is released
+ * while actually loading a configuration.
+ */
+void Context::loadReadyConfigs(std::vector<bool>& loaded, std::exception_ptr& failure) {
+	std::unique_lock<std::mutex> lock(m_assemblyLock);
+	while (true) {
+		// Wait for a configuration to become ready, unless there is no other configuration being loaded which could
+		// make one ready (in which case the assembly is done)
+		m_assemblyCondition.wait(lock, [this, &failure]() {
+			return failure || m_nextReadyConfig < m_readyConfigs.size() || m_numLoadingConfigs == 0;
+		});
+		if (failure || m_nextReadyConfig == m_readyConfigs.size())
+			break;
+
+		const std::size_t index = m_readyConfigs[m_nextReadyConfig++];
+		m_numLoadingConfigs++;
+		lock.unlock();
+
+		bool isLoaded = false;
+		std::exception_ptr error;
+		try {
+			isLoaded = loadConfig(m_waitingConfigs[index]);
+		} catch (...) {
+			error = std::current_exception();
+		}
+
+		lock.lock();
+		m_numLoadingConfigs--;
+		loaded[index] = isLoaded;
+		if (error && !failure)
+			failure = error;
+		m_assemblyCondition.notify_all();
+	}
+
+	// Make sure that any other thread waiting also sees that the assembly is done
+	m_assemblyCondition.notify_all();
+}
+
+/*
+ * Update the configurations waiting on the bean
+ */
+void Context::beanRegistered(const std::string& name) {
+	std::lock_guard<std::mutex> lock(m_assemblyLock);
+	if (m_missingResources.empty())
+		return;
+
+	// The slot remains in the table (without any waiter), so as not to break the probing of other resources
+	MissingResource& missing = findMissingResource(name);
+	for (std::size_t w = missing.firstWaiter; w != NO_WAITER; w = m_waiters[w].next) {
+		if (--m_numMissingResources[m_waiters[w].config] == 0) {
+			m_readyConfigs.push_back(m_waiters[w].config);
+			m_assemblyCondition.notify_one();
+		}
+	}
+	missing.firstWaiter = NO_WAITER;
+}
+
+/*
+ * Clean up after the assembly
+ */
+void Context::finishAssembly(const std::vector<bool>& loaded) {
+	std::lock_guard<std::mutex> lock(m_assemblyLock);
+	// The configurations were dequeued in the order in which they were loaded (which may only be partially so when
+	// loading on several threads, but any order in which a configuration follows the beans that it requires will do)
+	for (std::size_t i = 0; i < m_nextReadyConfig; i++) {
+		if (loaded[m_readyConfigs[i]])
+			m_loadOrder.push_back(std::uint32_t(m_readyConfigs[i]));
+	}
+
+	m_missingResources.clear();
+	m_missingResourceNames.clear();
+	m_waiters.clear();
+	m_numMissingResources.clear();
+	m_readyConfigs.clear();
+	m_nextReadyConfig = 0;
+	m_numLoadingConfigs = 0;
+
+	// Clean up the wrappers of the loaded configs, keeping the remaining ones in their original order
+	std::size_t numRemaining = 0;
+	for (std::size_t i = 0; i < m_waitingConfigs.size(); i++) {
+		if (loaded[i]) {
+			delete(m_waitingConfigs[i]);
+		} else {
+			m_waitingConfigs[i]->areResourcesSatisfied();
+			m_waitingConfigs[numRemaining++] = m_waitingConfigs[i];
+		}
+	}
+	m_waitingConfigs.resize(numRemaining);
+}
+
 /*
  * Try to load the configuration from the wrapper.
  */
 bool Context::loadConfig(ConfigurationWrapperInterface* wrapper) {
 	if (!wrapper->areResourcesSatisfied())
 		return false;
+	CORM_TRACE_SCOPE("configuration", wrapper->getName());
 
 	// The config has all of its resources/dependencies satisfied
 	// Create the config and initialize, process it
-	BaseConfiguration* config = wrapper->buildConfig();
+	initializeConfig(wrapper->buildConfig());
+	return true;
+}
+
+/*
+ * Initialize the configuration, keeping it as active if successful
+ */
+void Context::initializeConfig(BaseConfiguration* config) {
 	try {
 		config->initialize();
 	} catch (...) {
@@ -61,8 +314,8 @@ bool Context::loadConfig(ConfigurationWrapperInterface* wrapper) {
 	}
 
 	// Now that the configuration is created and initialized, store it
+	std::lock_guard<std::mutex> lock(m_assemblyLock);
 	m_activeConfigs.push_back(config);
-	return true;
 }
 
 /*
@@ -76,7 +329,7 @@ void checkForCycle(std::vector<ConfigurationWrapperInterface*>& configs) {
 	for (ConfigurationWrapperInterface* i: configs)
 		checker.add(i->getName(), i->getWaitingResources(), i->getBeanNames());
 	if (checker.checkForCycle()) {
-		throw ConfigurationCycleException(checker.getCycle());
+		throw ConfigurationCycleException(checker.getCycles());
 	}
 }
 
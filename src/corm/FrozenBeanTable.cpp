@@ -0,0 +1,129 @@
+#include "corm/FrozenBeanTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace corm {
+
+// The average number of beans per bucket (i.e.: the table has one seed for every two beans)
+static const std::size_t BEANS_PER_BUCKET = 2;
+// The number of times that the buckets are respread (with twice as many buckets) before giving up
+static const int MAX_RESPREADS = 4;
+
+/*
+ * Build the table, spreading the beans over more buckets if no seeds can be found
+ */
+FrozenBeanTable* FrozenBeanTable::build(const std::vector<Bean>& beans) {
+	FrozenBeanTable* table = new FrozenBeanTable();
+	if (beans.empty()) {
+		table->m_numBuckets = 1;
+		table->m_numSlots = 1;
+		table->m_seeds.push_back(0);
+		table->m_slots.push_back(Slot());
+		return table;
+	}
+
+	std::vector<std::uint64_t> hashes;
+	hashes.reserve(beans.size());
+	for (const Bean& b: beans)
+		hashes.push_back(hash(b.first));
+
+	// Beans sharing the same hash can never be told apart by any seed
+	std::vector<std::uint64_t> sorted = hashes;
+	std::sort(sorted.begin(), sorted.end());
+	if (std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end()) {
+		std::size_t numBuckets = (beans.size() + BEANS_PER_BUCKET - 1) / BEANS_PER_BUCKET;
+		for (int i = 0; i <= MAX_RESPREADS; i++, numBuckets *= 2) {
+			if (table->place(beans, hashes, numBuckets))
+				return table;
+		}
+	}
+
+	delete(table);
+	return NULL;
+}
+
+/*
+ * Get the number of beans
+ */
+std::size_t FrozenBeanTable::size() const {
+	return m_numSlots == 1 && m_slots[0].provider == NULL ? 0 : m_numSlots;
+}
+
+/*
+ * Place the largest buckets first, while most of the slots are still free, and for each search for the first
+ * seed which maps all of its beans to distinct free slots.
+ */
+bool FrozenBeanTable::place(const std::vector<Bean>& beans, const std::vector<std::uint64_t>& hashes, std::size_t numBuckets) {
+	const std::size_t numSlots = beans.size();
+
+	std::vector<std::vector<std::size_t>> buckets(numBuckets);
+	for (std::size_t i = 0; i < numSlots; i++)
+		buckets[bucketIndex(hashes[i], numBuckets)].push_back(i);
+
+	std::vector<std::size_t> order(numBuckets);
+	for (std::size_t b = 0; b < numBuckets; b++)
+		order[b] = b;
+	std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t l, std::size_t r) {
+		return buckets[l].size() > buckets[r].size();
+	});
+
+	// A bucket of one bean needs on average (slots / free slots) attempts, which is at most the number of slots
+	const std::uint64_t maxSeed = std::min<std::uint64_t>(UINT32_MAX, std::uint64_t(numSlots) * 64 + 1024);
+
+	std::vector<std::uint32_t> seeds(numBuckets, 0);
+	std::vector<std::size_t> slotOfBean(numSlots);
+	std::vector<bool> taken(numSlots, false);
+	std::vector<std::size_t> candidate;
+	for (std::size_t b: order) {
+		const std::vector<std::size_t>& bucket = buckets[b];
+		if (bucket.empty())
+			break;
+
+		bool placed = false;
+		for (std::uint64_t seed = 0; !placed && seed < maxSeed; seed++) {
+			candidate.clear();
+			for (std::size_t bean: bucket) {
+				std::size_t slot = slotIndex(hashes[bean], std::uint32_t(seed), numSlots);
+				if (taken[slot] || std::find(candidate.begin(), candidate.end(), slot) != candidate.end())
+					break;
+				candidate.push_back(slot);
+			}
+
+			if (candidate.size() == bucket.size()) {
+				placed = true;
+				seeds[b] = std::uint32_t(seed);
+				for (std::size_t i = 0; i < bucket.size(); i++) {
+					taken[candidate[i]] = true;
+					slotOfBean[bucket[i]] = candidate[i];
+				}
+			}
+		}
+
+		if (!placed)
+			return false;
+	}
+
+	// Lay out the slots
+	m_numBuckets = numBuckets;
+	m_numSlots = numSlots;
+	m_seeds = std::move(seeds);
+	m_slots.assign(numSlots, Slot());
+	m_overflow.clear();
+	for (std::size_t i = 0; i < numSlots; i++) {
+		const Bean& b = beans[i];
+		Slot& slot = m_slots[slotOfBean[i]];
+		slot.hash = hashes[i];
+		slot.provider = b.second;
+		slot.nameLength = std::uint32_t(b.first.size());
+		std::memcpy(slot.name, b.first.data(), std::min(b.first.size(), INLINE_NAME_LENGTH));
+		if (b.first.size() > INLINE_NAME_LENGTH) {
+			slot.overflowOffset = std::uint32_t(m_overflow.size());
+			m_overflow.append(b.first.substr(INLINE_NAME_LENGTH));
+		}
+	}
+
+	return true;
+}
+
+}
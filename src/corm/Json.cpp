@@ -0,0 +1,23 @@
+#include "corm/Json.h"
+
+#include <iomanip>
+
+namespace corm {
+
+/*
+ * Escape character by character
+ */
+void writeJsonString(std::ostream& os, std::string_view str) {
+	os << '"';
+	for (char c: str) {
+		if (c == '"' || c == '\\')
+			os << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20)
+			os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+		else
+			os << c;
+	}
+	os << '"';
+}
+
+}
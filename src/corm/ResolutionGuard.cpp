@@ -0,0 +1,60 @@
+#include "corm/ResolutionGuard.h"
+#include "corm/exception/InvalidBeanException.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace corm {
+
+// The chain and markers of each thread
+thread_local ResolutionGuard* ResolutionGuard::s_current = NULL;
+thread_local std::uint64_t ResolutionGuard::s_markers = 0;
+
+/*
+ * Get the "in progress" marker of the provider. Providers are allocated individually, so the low order bits
+ * of the address (past the alignment) spread consecutively allocated providers across the markers.
+ */
+static std::uint64_t resolutionMarker(const BaseProvider* provider) {
+	return std::uint64_t(1) << ((reinterpret_cast<std::uintptr_t>(provider) >> 4) & 63);
+}
+
+/*
+ * Check for a cycle, and link the bean into the chain of the current thread
+ */
+ResolutionGuard::ResolutionGuard(const BaseProvider* provider, std::string_view name):
+		m_provider(provider), m_name(name), m_parent(s_current), m_parentMarkers(s_markers) {
+	const std::uint64_t marker = resolutionMarker(provider);
+	if (m_parentMarkers & marker) {
+		// Confirm that it is actually the same provider, and not just one sharing its marker
+		for (const ResolutionGuard* g = m_parent; g != NULL; g = g->m_parent) {
+			if (g->m_provider == provider)
+				throwCycle();
+		}
+	}
+
+	s_current = this;
+	s_markers = m_parentMarkers | marker;
+}
+
+/*
+ * Unlink the bean from the chain of the current thread
+ */
+ResolutionGuard::~ResolutionGuard() {
+	s_current = m_parent;
+	s_markers = m_parentMarkers;
+}
+
+/*
+ * Build the full chain of names (outermost first), ending with the bean which closes the cycle
+ */
+void ResolutionGuard::throwCycle() const {
+	std::vector<std::string> cycle;
+	cycle.emplace_back(m_name);
+	for (const ResolutionGuard* g = m_parent; g != NULL; g = g->m_parent)
+		cycle.emplace_back(g->m_name);
+	std::reverse(cycle.begin(), cycle.end());
+	throw BeanDependencyCycleException(cycle);
+}
+
+}
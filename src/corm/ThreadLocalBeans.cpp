@@ -0,0 +1,91 @@
+#include "corm/ThreadLocalBeans.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace corm {
+
+// The id of the next ThreadLocalBeans
+static std::atomic<std::uint64_t> nextId(1);
+
+// The instances of each thread
+thread_local ThreadLocalBeans::ThreadSlots ThreadLocalBeans::t_slots;
+
+// CTOR
+ThreadLocalBeans::ThreadLocalBeans(void (*destroy)(void*)): m_id(nextId.fetch_add(1, std::memory_order_relaxed)),
+		m_shared(std::make_shared<Shared>()) {
+	m_shared->destroy = destroy;
+}
+
+// DTOR
+ThreadLocalBeans::~ThreadLocalBeans() {
+	std::vector<void*> instances;
+	{
+		std::lock_guard<std::mutex> lock(m_shared->lock);
+		m_shared->alive = false;
+		instances.swap(m_shared->instances);
+	}
+
+	// Any thread which still has a slot for one of these will no longer destroy it
+	for (void* instance: instances)
+		m_shared->destroy(instance);
+}
+
+/*
+ * Search the slots of the calling thread
+ */
+void* ThreadLocalBeans::find() const {
+	for (const Slot& slot: t_slots.slots) {
+		if (slot.id == m_id)
+			return slot.instance;
+	}
+	return NULL;
+}
+
+/*
+ * Add the slot to the calling thread, dropping the slots of any ThreadLocalBeans which have since ended. The instance
+ * is only registered as shared once the slot is in place, so that a failure leaves nothing which would destroy the
+ * instance (leaving that up to the caller).
+ */
+void ThreadLocalBeans::insert(void* instance) {
+	std::vector<Slot>& slots = t_slots.slots;
+	slots.erase(std::remove_if(slots.begin(), slots.end(), [](const Slot& slot) {
+		std::lock_guard<std::mutex> lock(slot.shared->lock);
+		return !slot.shared->alive;
+	}), slots.end());
+	slots.push_back(Slot{m_id, instance, m_shared});
+
+	try {
+		std::lock_guard<std::mutex> lock(m_shared->lock);
+		m_shared->instances.push_back(instance);
+	} catch (...) {
+		slots.pop_back();
+		throw;
+	}
+}
+
+/*
+ * Get the number of instances
+ */
+std::size_t ThreadLocalBeans::size() const {
+	std::lock_guard<std::mutex> lock(m_shared->lock);
+	return m_shared->instances.size();
+}
+
+/*
+ * Destroy the instances of the thread, unless their ThreadLocalBeans already did so
+ */
+ThreadLocalBeans::ThreadSlots::~ThreadSlots() {
+	for (Slot& slot: slots) {
+		{
+			std::lock_guard<std::mutex> lock(slot.shared->lock);
+			if (!slot.shared->alive)
+				continue;
+			std::vector<void*>& instances = slot.shared->instances;
+			instances.erase(std::find(instances.begin(), instances.end(), slot.instance));
+		}
+		slot.shared->destroy(slot.instance);
+	}
+}
+
+}
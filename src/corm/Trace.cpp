@@ -0,0 +1,114 @@
+#include "corm/Trace.h"
+#include "corm/Json.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace corm {
+
+std::atomic<bool> Trace::s_enabled(false);
+
+/*
+ * A single recorded event.
+ */
+struct TraceEvent {
+	// The name of the scope (empty for the end of a scope)
+	std::string name;
+	// The category of the scope
+	const char* category;
+	// 'B' for the beginning of a scope, 'E' for the end
+	char phase;
+	// The time of the event, in microseconds since the recording started
+	double timestamp;
+	// The thread on which the event took place
+	unsigned int thread;
+};
+
+// The state of the recording, only accessed while holding the lock
+static std::mutex traceLock;
+static std::string tracePath;
+static std::vector<TraceEvent> traceEvents;
+static std::chrono::steady_clock::time_point traceStart;
+
+// Each thread is identified by a small number, in the order in which the threads record their first event
+static std::atomic<unsigned int> nextThreadId(1);
+
+/*
+ * Get the id of the calling thread.
+ *
+ * @return unsigned int the id of the thread
+ */
+static unsigned int currentThreadId() {
+	thread_local unsigned int threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+	return threadId;
+}
+
+/*
+ * Record the event.
+ *
+ * @param category const char* the category of the scope
+ * @param phase char the phase of the event
+ * @param name const std::string& the name of the scope
+ */
+static void record(const char* category, char phase, const std::string& name) {
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	const unsigned int thread = currentThreadId();
+	std::lock_guard<std::mutex> lock(traceLock);
+	traceEvents.push_back(TraceEvent{name, category, phase,
+			std::chrono::duration<double, std::micro>(now - traceStart).count(), thread});
+}
+
+/*
+ * Start recording
+ */
+void Trace::start(const std::string& path) {
+	std::lock_guard<std::mutex> lock(traceLock);
+	tracePath = path;
+	traceEvents.clear();
+	traceStart = std::chrono::steady_clock::now();
+	s_enabled.store(true, std::memory_order_relaxed);
+}
+
+/*
+ * Stop recording and write the events
+ */
+bool Trace::stop() {
+	std::lock_guard<std::mutex> lock(traceLock);
+	s_enabled.store(false, std::memory_order_relaxed);
+
+	std::ofstream out(tracePath);
+	out << "{\"traceEvents\": [";
+	out << std::fixed << std::setprecision(3);
+	for (std::size_t i = 0; i < traceEvents.size(); i++) {
+		const TraceEvent& e = traceEvents[i];
+		out << (i == 0 ? "\n" : ",\n") << "  {\"ph\": \"" << e.phase << "\", \"cat\": ";
+		writeJsonString(out, e.category);
+		if (e.phase == 'B') {
+			out << ", \"name\": ";
+			writeJsonString(out, e.name);
+		}
+		out << ", \"ts\": " << e.timestamp << ", \"pid\": 1, \"tid\": " << e.thread << "}";
+	}
+	out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+	traceEvents.clear();
+	return bool(out);
+}
+
+/*
+ * Record the beginning
+ */
+void Trace::begin(const char* category, const std::string& name) {
+	record(category, 'B', name);
+}
+
+/*
+ * Record the end
+ */
+void Trace::end(const char* category) {
+	record(category, 'E', std::string());
+}
+
+}
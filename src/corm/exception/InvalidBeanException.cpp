@@ -6,6 +6,8 @@
 
 namespace corm {
 
+std::ostream& operator<<(std::ostream& os, const ConfigurationWrapperInterface* w);
+
 /*
  * Helper functions which translates a vector to a human readable string form. Note, that the type of
  * stored within the vector must support the << operator.
@@ -55,6 +57,15 @@ ConfigurationInitializationException::ConfigurationInitializationException(const
 	std::runtime_error("Unable to initialize configurations: " + vectorAsString(wrappers)){
 }
 
+/*
+ * Properly "convert" the ConfigurationWrapperInterface to string for exception reporting purposes. Declared within
+ * the namespace (ahead of vectorAsString), so that it is found in place of the generic pointer output.
+ */
+std::ostream& operator<<(std::ostream& os, const ConfigurationWrapperInterface* w) {
+	os << w->getName() << " is missing resources " << vectorAsString(w->getWaitingResources());
+	return os;
+}
+
 /*
  * Constructor that converts the vector of a config cycle vector to a string
  */
@@ -62,12 +73,28 @@ ConfigurationCycleException::ConfigurationCycleException(const std::vector<std::
 	std::runtime_error("Configuration cycle detected " + vectorAsString(cycle)) {
 }
 
+/*
+ * Helper function which translates all of the cycles to a string, each cycle in the same form as a single cycle
+ *
+ * @param cycles const std::vector<std::vector<std::string>>& the cycles to convert
+ *
+ * @return std::string the string representation of the cycles
+ */
+static std::string cyclesAsString(const std::vector<std::vector<std::string>>& cycles) {
+	std::string str;
+	for (const std::vector<std::string>& cycle: cycles) {
+		if (!str.empty())
+			str += ", ";
+		str += vectorAsString(cycle);
+	}
+	return str;
 }
 
 /*
- * Properly "convert" the ConfigurationWrapperInterface to string for exception reporting purposes
+ * Constructor that converts all of the config cycles to a string
  */
-std::ostream& operator<<(std::ostream& os, const corm::ConfigurationWrapperInterface* w) {
-	os << w->getName() << " is missing resources " << corm::vectorAsString(w->getWaitingResources());
-	return os;
+ConfigurationCycleException::ConfigurationCycleException(const std::vector<std::vector<std::string>>& cycles):
+	std::runtime_error("Configuration cycle detected " + cyclesAsString(cycles)) {
+}
+
 }
@@ -0,0 +1,70 @@
+#ifndef COPYCOUNTED_H_
+#define COPYCOUNTED_H_
+
+#include <memory>
+
+/*
+ * Bean which counts how often any instance is copied and moved.
+ */
+class CopyCounted {
+
+public:
+	CopyCounted(): value(0) {}
+
+	CopyCounted(int val): value(val) {}
+
+	CopyCounted(const CopyCounted& other): value(other.value) {
+		numCopies++;
+	}
+
+	CopyCounted(CopyCounted&& other) noexcept: value(other.value) {
+		numMoves++;
+	}
+
+	CopyCounted& operator=(const CopyCounted& other) {
+		value = other.value;
+		numCopies++;
+		return *this;
+	}
+
+	CopyCounted& operator=(CopyCounted&& other) noexcept {
+		value = other.value;
+		numMoves++;
+		return *this;
+	}
+
+	int getValue() const { return value; }
+
+	// Reset the counts
+	static void resetCounts() {
+		numCopies = 0;
+		numMoves = 0;
+	}
+
+	static inline int numCopies = 0;
+	static inline int numMoves = 0;
+
+private:
+	int value;
+};
+
+/*
+ * Bean which can only be moved, exclusively owning its value.
+ */
+class MoveOnly {
+
+public:
+	MoveOnly(): value(std::make_unique<int>(0)) {}
+
+	MoveOnly(int val): value(std::make_unique<int>(val)) {}
+
+	MoveOnly(MoveOnly&&) = default;
+	MoveOnly& operator=(MoveOnly&&) = default;
+
+	int getValue() const { return *value; }
+
+private:
+	std::unique_ptr<int> value;
+};
+
+#endif /* COPYCOUNTED_H_ */
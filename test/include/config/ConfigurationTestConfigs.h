@@ -79,4 +79,25 @@ CONFIGURATION(ConsumerTestConfig)
 
 END_CONFIGURATION
 
+
+
+// Configuration that pulls in the resources provided by ProviderTestConfig as handles
+CONFIGURATION(RefConsumerTestConfig)
+
+	public:
+		corm::BeanRef<DummyClass>& getProviderDummyClassFactory() {
+			return providerDummyClassFactory;
+		}
+
+		corm::BeanRef<DummyClass*>& getProviderDummyClassSingleton() {
+			return singleton;
+		}
+
+	RESOURCES(
+			(corm::BeanRef<DummyClass>, providerDummyClassFactory),
+			(corm::BeanRef<DummyClass*>, "providerDummyClassSingleton", singleton)
+	)
+
+END_CONFIGURATION
+
 #endif /* CONFIG_CONFIGURATIONTESTCONFIGS_H_ */
@@ -2,6 +2,7 @@
 #define CONFIG_CONTEXTTESTCONFIGS_H_
 
 #include "corm/Configuration.h"
+#include "DummyClass.h"
 
 // Configuration which required a couple of resources, which are expected to be missing.
 CONFIGURATION(SingleConfigMissingResourcesTestConfig)
@@ -32,4 +33,13 @@ CONFIGURATION(ProvideBean2Config)
 
 END_CONFIGURATION
 
+// Configuration which provides a bean of which each thread has its own instance
+CONFIGURATION(ThreadLocalBeanConfig)
+
+	BEANS(
+			(BEAN, DummyClass*, corm::ThreadLocalBeanCreator<DummyClass*>, "threadLocalDummy")
+	)
+
+END_CONFIGURATION
+
 #endif /* CONFIG_CONTEXTTESTCONFIGS_H_ */
@@ -0,0 +1,83 @@
+#ifndef CONFIG_CONTEXTTESTPARALLELCONFIGS_H_
+#define CONFIG_CONTEXTTESTPARALLELCONFIGS_H_
+
+#include "corm/Configuration.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Number of parallel configurations which must be initializing at the same time
+const int numParallelConfigs = 4;
+// Number of parallel configurations which have started to initialize
+std::atomic<int> numStartedParallelConfigs(0);
+
+/*
+ * Configuration which, during its initialization, waits for all of the other parallel configurations to be initializing
+ * as well. As this can only happen if the configurations are initialized in parallel, the wait is limited and the
+ * configuration provides the bean "parallelN" indicating whether or not the wait was successful.
+ */
+template<int N>
+class ParallelTestConfig: public corm::BaseConfiguration {
+public:
+	ParallelTestConfig(corm::BeanManager* manager): BaseConfiguration(manager) {}
+
+	static std::string getName() {
+		return "ParallelTestConfig" + std::to_string(N);
+	}
+
+	static const std::vector<std::string>& getBeanNames() {
+		static std::vector<std::string> beans{"parallel" + std::to_string(N)};
+		return beans;
+	}
+
+protected:
+	void postInit() {
+		numStartedParallelConfigs++;
+		std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (numStartedParallelConfigs < numParallelConfigs && std::chrono::steady_clock::now() < timeout)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		m_allStarted = numStartedParallelConfigs >= numParallelConfigs;
+	}
+
+	void provideBeans() {
+		m_beanManager->registerBeanInstance<bool>("parallel" + std::to_string(N), m_allStarted);
+	}
+
+private:
+	bool m_allStarted = false;
+};
+
+// Configuration which requires the beans from all of the parallel configurations
+CONFIGURATION(ParallelConsumerTestConfig)
+
+	RESOURCES(
+			(bool, parallel0),
+			(bool, parallel1),
+			(bool, parallel2),
+			(bool, parallel3)
+	)
+
+	BEANS(
+			(BEAN_INSTANCE, bool, "allParallel", allParallel)
+	)
+
+private:
+	bool allParallel = parallel0 && parallel1 && parallel2 && parallel3;
+
+END_CONFIGURATION
+
+// Configuration which fails to initialize
+CONFIGURATION(FailingTestConfig)
+
+protected:
+	void postInit() {
+		throw std::runtime_error("Failed to initialize");
+	}
+
+END_CONFIGURATION
+
+#endif /* CONFIG_CONTEXTTESTPARALLELCONFIGS_H_ */
@@ -0,0 +1,71 @@
+#ifndef CONFIG_CONTEXTTESTRUNTIMECONFIGS_H_
+#define CONFIG_CONTEXTTESTRUNTIMECONFIGS_H_
+
+#include "corm/Context.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * Configuration which is only defined at runtime, providing the bean "<prefix>N" (the value of which is N), and
+ * requiring the bean "<prefix>(N-1)" unless it is the first one.
+ */
+class RuntimeTestConfig: public corm::BaseConfiguration {
+public:
+	RuntimeTestConfig(corm::BeanManager* manager, const std::string& prefix, int n): BaseConfiguration(manager),
+			m_prefix(prefix), m_n(n) {}
+
+protected:
+	void provideBeans() {
+		m_beanManager->registerBeanInstance<int>(m_prefix + std::to_string(m_n), m_n);
+	}
+
+private:
+	std::string m_prefix;
+	int m_n;
+};
+
+/*
+ * Wrapper through which the RuntimeTestConfig is registered. The waiting resources are owned by the wrapper, and
+ * shrink as they become available.
+ */
+class RuntimeTestConfigWrapper: public corm::ConfigurationWrapperInterface {
+public:
+	RuntimeTestConfigWrapper(corm::BeanManager* manager, const std::string& prefix, int n): m_beanManager(manager),
+			m_prefix(prefix), m_n(n), m_beanNames{prefix + std::to_string(n)} {
+		if (n > 0)
+			m_waitingResources.push_back(prefix + std::to_string(n - 1));
+	}
+
+	std::string getName() const {
+		return "RuntimeTestConfig" + std::to_string(m_n);
+	}
+
+	bool areResourcesSatisfied() {
+		m_waitingResources.erase(std::remove_if(m_waitingResources.begin(), m_waitingResources.end(),
+				[this](const std::string& s) { return m_beanManager->containsBean(s); }), m_waitingResources.end());
+		return m_waitingResources.empty();
+	}
+
+	corm::BaseConfiguration* buildConfig() {
+		return new RuntimeTestConfig(m_beanManager, m_prefix, m_n);
+	}
+
+	const std::vector<std::string>& getWaitingResources() const {
+		return m_waitingResources;
+	}
+
+	const std::vector<std::string>& getBeanNames() const {
+		return m_beanNames;
+	}
+
+private:
+	corm::BeanManager* m_beanManager;
+	std::string m_prefix;
+	int m_n;
+	std::vector<std::string> m_waitingResources;
+	std::vector<std::string> m_beanNames;
+};
+
+#endif /* CONFIG_CONTEXTTESTRUNTIMECONFIGS_H_ */
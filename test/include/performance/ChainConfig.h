@@ -0,0 +1,51 @@
+#ifndef PERFORMANCE_CHAINCONFIG_H_
+#define PERFORMANCE_CHAINCONFIG_H_
+
+#include "corm/Context.h"
+
+#include <string>
+#include <vector>
+
+/*
+ * Configuration which provides the bean "chainN", and requires the bean "chain(N-1)" provided by the previous
+ * configuration in the chain (the first configuration of the chain requires nothing). Written out by hand
+ * rather than through the macros, so that a chain of any length can be generated.
+ */
+template<int N>
+class ChainConfig: public corm::BaseConfiguration {
+public:
+	ChainConfig(corm::BeanManager* manager): BaseConfiguration(manager) {}
+
+	static std::string getName() {
+		return "ChainConfig" + std::to_string(N);
+	}
+
+	static const std::vector<std::string>& getResourceNames() {
+		static std::vector<std::string> resources = N == 0 ? std::vector<std::string>() :
+				std::vector<std::string>{"chain" + std::to_string(N - 1)};
+		return resources;
+	}
+
+	static const std::vector<std::string>& getBeanNames() {
+		static std::vector<std::string> beans{"chain" + std::to_string(N)};
+		return beans;
+	}
+
+protected:
+	void provideBeans() {
+		m_beanManager->registerBeanInstance<int>("chain" + std::to_string(N), N);
+	}
+};
+
+/*
+ * Register the entire chain with the context, from the last configuration to the first (the worst case order,
+ * as each configuration is registered before the one it depends on).
+ */
+template<int N>
+void registerChainConfigs(corm::Context& context) {
+	context.registerConfiguration<ChainConfig<N>>();
+	if constexpr (N > 0)
+		registerChainConfigs<N - 1>(context);
+}
+
+#endif /* PERFORMANCE_CHAINCONFIG_H_ */
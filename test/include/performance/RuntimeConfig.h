@@ -93,4 +93,26 @@ protected:
 
 END_CONFIGURATION
 
+// Configuration of a single request, which relies on the beans of an assembled RootRuntimeConfig (in a parent context).
+CONFIGURATION(RequestRuntimeConfig)
+
+protected:
+	void postInit() {
+		requestDummy = DummyClass(int1Dummy.getValue() + int3);
+	}
+
+	BEANS(
+			(BEAN_INSTANCE, DummyClass&, requestDummy)
+	)
+
+	RESOURCES(
+			(DummyClass&, int1Dummy),
+			(int&, int3)
+	)
+
+private:
+	DummyClass requestDummy;
+
+END_CONFIGURATION
+
 #endif /* PERFORMANCE_RUNTIMECONFIG_H_ */
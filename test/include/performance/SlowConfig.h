@@ -0,0 +1,52 @@
+#ifndef PERFORMANCE_SLOWCONFIG_H_
+#define PERFORMANCE_SLOWCONFIG_H_
+
+#include "corm/Context.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Time that each slow configuration takes to initialize (i.e.: opening a connection pool, or loading a model)
+const std::chrono::milliseconds slowConfigInitTime(50);
+
+/*
+ * Configuration which provides the bean "slowN", and takes a while to initialize. None of the slow configurations
+ * depend on each other.
+ */
+template<int N>
+class SlowConfig: public corm::BaseConfiguration {
+public:
+	SlowConfig(corm::BeanManager* manager): BaseConfiguration(manager) {}
+
+	static std::string getName() {
+		return "SlowConfig" + std::to_string(N);
+	}
+
+	static const std::vector<std::string>& getBeanNames() {
+		static std::vector<std::string> beans{"slow" + std::to_string(N)};
+		return beans;
+	}
+
+protected:
+	void postInit() {
+		std::this_thread::sleep_for(slowConfigInitTime);
+	}
+
+	void provideBeans() {
+		m_beanManager->registerBeanInstance<int>("slow" + std::to_string(N), N);
+	}
+};
+
+/*
+ * Register the slow configurations 0 through N with the context.
+ */
+template<int N>
+void registerSlowConfigs(corm::Context& context) {
+	context.registerConfiguration<SlowConfig<N>>();
+	if constexpr (N > 0)
+		registerSlowConfigs<N - 1>(context);
+}
+
+#endif /* PERFORMANCE_SLOWCONFIG_H_ */
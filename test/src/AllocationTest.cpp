@@ -0,0 +1,175 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "corm/BeanManager.h"
+#include "DummyClass.h"
+
+// Number of allocations performed through the global operator new, across the entire test binary
+static std::atomic<long> numAllocations(0);
+
+void* operator new(std::size_t size) {
+	numAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+// Number of times that each bean is retrieved while counting the allocations
+static const int numOfRetrievals = 100;
+
+/*
+ * Helper which retrieves the bean from the provider repeatedly, and counts the number of allocations that
+ * took place while doing so.
+ */
+template<typename T>
+long countProviderAllocations(corm::TypeProvider<T>& provider) {
+	long before = numAllocations.load();
+	for (int i = 0; i < numOfRetrievals; i++)
+		provider.getBean();
+	return numAllocations.load() - before;
+}
+
+/*
+ * Helper which retrieves the bean from the manager repeatedly, and counts the number of allocations that
+ * took place while doing so.
+ */
+template<typename T>
+long countManagerAllocations(corm::BeanManager& manager, const char* name) {
+	long before = numAllocations.load();
+	for (int i = 0; i < numOfRetrievals; i++)
+		manager.getBean<T>(name);
+	return numAllocations.load() - before;
+}
+
+BOOST_AUTO_TEST_SUITE(Allocation_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Singleton_provider_does_not_allocate) {
+	corm::BeanCreatorProvider<DummyClass*, corm::SingletonBeanCreator<DummyClass*>> pointerProvider;
+	// The first retrieval creates the singleton instance
+	long before = numAllocations.load();
+	pointerProvider.getBean();
+	BOOST_CHECK_EQUAL(1, numAllocations.load() - before);
+	BOOST_CHECK_EQUAL(0, countProviderAllocations(pointerProvider));
+
+	corm::BeanCreatorProvider<DummyClass&, corm::SingletonBeanCreator<DummyClass&>> referenceProvider;
+	BOOST_CHECK_EQUAL(0, countProviderAllocations(referenceProvider));
+}
+
+BOOST_AUTO_TEST_CASE(Smart_singleton_provider_allocates_once) {
+	corm::BeanCreatorProvider<std::shared_ptr<DummyClass>, corm::SmartSingletonBeanCreator<DummyClass>> provider;
+	// The instance and its reference count share a single allocation
+	long before = numAllocations.load();
+	provider.getBean();
+	BOOST_CHECK_EQUAL(1, numAllocations.load() - before);
+	BOOST_CHECK_EQUAL(0, countProviderAllocations(provider));
+
+	corm::BeanCreatorProvider<std::shared_ptr<DummyClass>, corm::SmartFactoryBeanCreator<DummyClass>> factoryProvider;
+	BOOST_CHECK_EQUAL(numOfRetrievals, countProviderAllocations(factoryProvider));
+}
+
+BOOST_AUTO_TEST_CASE(Instance_provider_does_not_allocate) {
+	DummyClass instance(123);
+	corm::BeanInstanceProvider<DummyClass*> pointerProvider(&instance);
+	BOOST_CHECK_EQUAL(0, countProviderAllocations(pointerProvider));
+
+	corm::BeanInstanceProvider<DummyClass&> referenceProvider(instance);
+	BOOST_CHECK_EQUAL(0, countProviderAllocations(referenceProvider));
+
+	corm::BeanInstanceProvider<DummyClass> scalarProvider(instance);
+	BOOST_CHECK_EQUAL(0, countProviderAllocations(scalarProvider));
+}
+
+BOOST_AUTO_TEST_CASE(Manager_singleton_and_instance_do_not_allocate) {
+	DummyClass instance(123);
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*>("ptr");
+	manager.registerBean<DummyClass&>("ref");
+	manager.registerBeanInstance<DummyClass*>("instPtr", &instance);
+	manager.registerBeanInstance<DummyClass&>("instRef", instance);
+	manager.registerBeanInstance<DummyClass>("instScalar", instance);
+	// Name which is too long for the small string optimization, to show that the name is never copied
+	manager.registerBeanInstance<DummyClass*>("a.rather.long.instance.bean.name", &instance);
+
+	// Warm up, creating the singleton pointer
+	manager.getBean<DummyClass*>("ptr");
+
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<DummyClass*>(manager, "ptr"));
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<DummyClass&>(manager, "ref"));
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<DummyClass*>(manager, "instPtr"));
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<DummyClass&>(manager, "instRef"));
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<DummyClass>(manager, "instScalar"));
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<DummyClass*>(manager, "a.rather.long.instance.bean.name"));
+
+	// Same goes for retrieving through a handle
+	corm::BeanRef<DummyClass*> ref = manager.getBeanRef<DummyClass*>("ptr");
+	long before = numAllocations.load();
+	for (int i = 0; i < numOfRetrievals; i++)
+		ref.get();
+	BOOST_CHECK_EQUAL(0, numAllocations.load() - before);
+}
+
+BOOST_AUTO_TEST_CASE(Scoped_beans_do_not_allocate) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*, corm::ScopedBeanCreator<DummyClass*>>("scoped");
+	manager.registerBean<DummyClass*, corm::ScopedFactoryBeanCreator<DummyClass*>>("scopedFactory");
+
+	// The beans of a small request fit within the arena of the scope itself
+	long before = numAllocations.load();
+	{
+		corm::BeanScope scope;
+		for (int i = 0; i < 10; i++) {
+			manager.getBean<DummyClass*>("scoped");
+			manager.getBean<DummyClass*>("scopedFactory");
+		}
+		BOOST_CHECK_EQUAL(11, scope.size());
+	}
+	BOOST_CHECK_EQUAL(0, numAllocations.load() - before);
+}
+
+BOOST_AUTO_TEST_CASE(Instance_const_reference_does_not_allocate) {
+	corm::BeanManager manager;
+	manager.registerBeanInstance<std::vector<int>>("vector", std::vector<int>(1000, 7));
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<const std::vector<int>&>(manager, "vector"));
+	BOOST_CHECK_EQUAL(numOfRetrievals, countManagerAllocations<std::vector<int>>(manager, "vector"));
+}
+
+BOOST_AUTO_TEST_CASE(Pooled_beans_do_not_allocate) {
+	corm::BeanManager manager;
+	manager.registerBean<corm::PooledBean<DummyClass>, corm::PooledBeanCreator<DummyClass>>("pooled");
+
+	// Warm up, filling the pool
+	manager.getBean<corm::PooledBean<DummyClass>>("pooled");
+
+	BOOST_CHECK_EQUAL(0, countManagerAllocations<corm::PooledBean<DummyClass>>(manager, "pooled"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
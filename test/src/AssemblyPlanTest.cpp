@@ -0,0 +1,169 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "corm/AssemblyPlan.h"
+#include "corm/Context.h"
+#include "config/ContextTestDependenctConfigs.h"
+#include "config/ContextTestRuntimeConfigs.h"
+
+/*
+ * Helper which gets the path of a temporary file for the test.
+ */
+static std::string tempPath(const std::string& name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/*
+ * Helper which registers a chain of runtime configurations in reverse, so that the normal assembly has to resolve
+ * the order in which to load them.
+ */
+static void registerChain(corm::Context& context, int length) {
+	for (int i = length - 1; i >= 0; i--)
+		context.registerConfiguration(new RuntimeTestConfigWrapper(&context, "planned", i));
+}
+
+/*
+ * Helper which registers the dependent configurations, consumer first.
+ */
+static void registerDependent(corm::Context& context) {
+	context.registerConfiguration<ConsumerManagerTestConfig>();
+	context.registerConfiguration<ProviderConsumerManagerTestConfig>();
+	context.registerConfiguration<ProviderManagerTestConfig>();
+}
+
+BOOST_AUTO_TEST_SUITE(AssemblyPlan_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Plan_Round_Trip) {
+	const std::string path = tempPath("corm_plan_round_trip.bin");
+	corm::AssemblyPlan plan(1234, {2, 0, 1});
+	BOOST_REQUIRE(plan.write(path));
+	// The magic, version, fingerprint and load order, nothing else
+	BOOST_CHECK_EQUAL(8 + 4 + 8 + 4 + 3 * 4, std::filesystem::file_size(path));
+
+	corm::AssemblyPlan read;
+	BOOST_CHECK(read.isEmpty());
+	BOOST_REQUIRE(read.read(path));
+	BOOST_CHECK(!read.isEmpty());
+	BOOST_CHECK_EQUAL(1234, read.getFingerprint());
+	BOOST_CHECK(plan.getLoadOrder() == read.getLoadOrder());
+	std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(Invalid_Plan_Files) {
+	const std::string path = tempPath("corm_plan_invalid.bin");
+	corm::AssemblyPlan plan;
+	BOOST_CHECK(!plan.read(tempPath("corm_plan_does_not_exist.bin")));
+
+	// Not a plan at all
+	std::ofstream(path, std::ios::binary) << "CORMPLAM and then some more data";
+	BOOST_CHECK(!plan.read(path));
+	BOOST_CHECK(plan.isEmpty());
+
+	// A plan cut short, or with data trailing behind it
+	BOOST_REQUIRE(corm::AssemblyPlan(99, {0, 1}).write(path));
+	const std::uintmax_t size = std::filesystem::file_size(path);
+	std::filesystem::resize_file(path, size - 1);
+	BOOST_CHECK(!plan.read(path));
+	BOOST_CHECK(plan.isEmpty());
+	std::filesystem::resize_file(path, size + 1);
+	BOOST_CHECK(!plan.read(path));
+	BOOST_CHECK(plan.isEmpty());
+	std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(Fingerprint_Follows_Configurations) {
+	corm::Context context;
+	RuntimeTestConfigWrapper a(&context, "x", 1), b(&context, "x", 2), c(&context, "y", 1);
+	const std::uint64_t ab = corm::AssemblyPlan::fingerprint({&a, &b});
+	BOOST_CHECK_EQUAL(ab, corm::AssemblyPlan::fingerprint({&a, &b}));
+	BOOST_CHECK_NE(ab, corm::AssemblyPlan::fingerprint({&b, &a}));
+	BOOST_CHECK_NE(ab, corm::AssemblyPlan::fingerprint({&a, &c}));
+	BOOST_CHECK_NE(ab, corm::AssemblyPlan::fingerprint({&a}));
+}
+
+BOOST_AUTO_TEST_CASE(Saved_Plan_Followed) {
+	const std::string path = tempPath("corm_plan_followed.bin");
+	{
+		corm::Context context;
+		registerChain(context, 100);
+		context.assemble();
+		BOOST_CHECK_EQUAL(0, context.getNumPlannedConfigs());
+		BOOST_REQUIRE(context.saveAssemblyPlan(path));
+	}
+
+	corm::AssemblyPlan plan;
+	BOOST_REQUIRE(plan.read(path));
+	BOOST_CHECK_EQUAL(100, plan.getLoadOrder().size());
+	BOOST_CHECK_EQUAL(99, plan.getLoadOrder().front());
+	BOOST_CHECK_EQUAL(0, plan.getLoadOrder().back());
+
+	corm::Context context;
+	registerChain(context, 100);
+	BOOST_REQUIRE(context.loadAssemblyPlan(path));
+	context.assemble();
+	BOOST_CHECK_EQUAL(100, context.getNumPlannedConfigs());
+	BOOST_CHECK_EQUAL(0, context.getBean<int>("planned0"));
+	BOOST_CHECK_EQUAL(99, context.getBean<int>("planned99"));
+	std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(Plan_For_Other_Configurations) {
+	const std::string path = tempPath("corm_plan_other.bin");
+	{
+		corm::Context context;
+		registerChain(context, 10);
+		context.assemble();
+		BOOST_REQUIRE(context.saveAssemblyPlan(path));
+	}
+
+	corm::Context context;
+	registerChain(context, 11);
+	BOOST_CHECK(!context.loadAssemblyPlan(path));
+	context.assemble();
+	BOOST_CHECK_EQUAL(0, context.getNumPlannedConfigs());
+	BOOST_CHECK_EQUAL(10, context.getBean<int>("planned10"));
+	std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(Incomplete_Assembly_Not_Saved) {
+	const std::string path = tempPath("corm_plan_incomplete.bin");
+	corm::Context context;
+	context.registerConfiguration(new RuntimeTestConfigWrapper(&context, "incomplete", 1));
+	BOOST_REQUIRE_THROW(context.assemble(), corm::ConfigurationInitializationException);
+	BOOST_CHECK(!context.saveAssemblyPlan(path));
+	BOOST_CHECK(!std::filesystem::exists(path));
+}
+
+BOOST_AUTO_TEST_CASE(Wrong_Plan_Falls_Back) {
+	const std::string path = tempPath("corm_plan_wrong.bin");
+	corm::Context context;
+	registerDependent(context);
+
+	// The plan is for the very same configurations, but loads the provider and then the consumer (which is still
+	// missing the bean of the middle configuration)
+	{
+		corm::Context other;
+		corm::ConfigurationWrapper<ConsumerManagerTestConfig> consumer(&other);
+		corm::ConfigurationWrapper<ProviderConsumerManagerTestConfig> providerConsumer(&other);
+		corm::ConfigurationWrapper<ProviderManagerTestConfig> provider(&other);
+		BOOST_REQUIRE(corm::AssemblyPlan(corm::AssemblyPlan::fingerprint({&consumer, &providerConsumer, &provider}),
+				{2, 0, 1}).write(path));
+	}
+
+	BOOST_REQUIRE(context.loadAssemblyPlan(path));
+	context.assemble();
+	BOOST_CHECK_EQUAL(1, context.getNumPlannedConfigs());
+	BOOST_CHECK(context.containsBean("providerManagerDummySingleton"));
+	BOOST_CHECK(context.containsBean("providerConsumerDummyFactory"));
+	std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
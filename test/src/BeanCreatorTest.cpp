@@ -6,22 +6,75 @@
 
 #include "corm/BeanCreator.h"
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include "DummyClass.h"
 
+// Number of threads which race to create the singleton, and number of times that the race is run
+static const int numOfRacingThreads = 8;
+static const int numOfRaces = 200;
+
+// Number of times that a SlowConstruction was constructed
+static std::atomic<int> numConstructions(0);
+
+/*
+ * Bean which takes a while to construct, widening the window in which other threads can request it.
+ */
+struct SlowConstruction {
+	SlowConstruction() {
+		numConstructions.fetch_add(1, std::memory_order_relaxed);
+		std::this_thread::sleep_for(std::chrono::microseconds(50));
+		value = 42;
+	}
+
+	int value;
+};
+
+// Whether the construction of a FailingConstruction is to throw
+static bool failConstruction = false;
+
+/*
+ * Bean whose construction fails on request.
+ */
+struct FailingConstruction {
+	FailingConstruction() {
+		if (failConstruction)
+			throw std::runtime_error("construction failed");
+	}
+};
+
+// Number of ThreadLocalTracked that currently exist
+static std::atomic<int> numThreadLocalTracked(0);
+
+/*
+ * Bean which tracks how many instances exist.
+ */
+struct ThreadLocalTracked {
+	ThreadLocalTracked() {
+		numThreadLocalTracked.fetch_add(1);
+	}
+	~ThreadLocalTracked() {
+		numThreadLocalTracked.fetch_sub(1);
+	}
+
+	int value = 0;
+};
+
 BOOST_AUTO_TEST_SUITE(BeanCreator_Test_Suite)
 
 
 BOOST_AUTO_TEST_CASE(Singleton_Scalar_Creator) {
 	corm::SingletonBeanCreator<DummyClass&> creator;
 
-	corm::ValueWrapper<DummyClass&>* wrapper = creator.create();
-	DummyClass& dummy1 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass& dummy1 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy1.getValue());
 
-	wrapper = creator.create();
-	DummyClass& dummy2 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass& dummy2 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy2.getValue());
 
 	// Verify that it is the same instance
@@ -35,14 +88,10 @@ BOOST_AUTO_TEST_CASE(Singleton_Scalar_Creator) {
 BOOST_AUTO_TEST_CASE(Singleton_Pointer_Creator) {
 	corm::SingletonBeanCreator<DummyClass*> creator;
 
-	corm::ValueWrapper<DummyClass*>* wrapper = creator.create();
-	DummyClass* dummy1 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass* dummy1 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy1->getValue());
 
-	wrapper = creator.create();
-	DummyClass* dummy2 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass* dummy2 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy2->getValue());
 
 	// Verify that it is the same instance
@@ -56,14 +105,10 @@ BOOST_AUTO_TEST_CASE(Singleton_Pointer_Creator) {
 BOOST_AUTO_TEST_CASE(Factory_Scalar_Creator) {
 	corm::FactoryBeanCreator<DummyClass> creator;
 
-	corm::ValueWrapper<DummyClass>* wrapper = creator.create();
-	DummyClass dummy1 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass dummy1 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy1.getValue());
 
-	wrapper = creator.create();
-	DummyClass dummy2 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass dummy2 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy2.getValue());
 
 	// Verify that it is the same instance
@@ -76,14 +121,10 @@ BOOST_AUTO_TEST_CASE(Factory_Scalar_Creator) {
 BOOST_AUTO_TEST_CASE(Factory_Pointer_Creator) {
 	corm::FactoryBeanCreator<DummyClass*> creator;
 
-	corm::ValueWrapper<DummyClass*>* wrapper = creator.create();
-	DummyClass* dummy1 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass* dummy1 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy1->getValue());
 
-	wrapper = creator.create();
-	DummyClass* dummy2 = wrapper->m_value;
-	delete(wrapper);
+	DummyClass* dummy2 = creator.create();
 	BOOST_CHECK_EQUAL(0, dummy2->getValue());
 
 	// Verify that it is the same instance
@@ -100,39 +141,207 @@ BOOST_AUTO_TEST_CASE(Smart_Singleton_Creator) {
 	corm::SmartSingletonBeanCreator<DummyClass> creator;
 
 	// Get one instance
-	corm::ValueWrapper<std::shared_ptr<DummyClass>>* wrapper = creator.create();
-	std::shared_ptr<DummyClass> bean1 = wrapper->m_value;
-	delete(wrapper);
+	std::shared_ptr<DummyClass> bean1 = creator.create();
 	BOOST_CHECK_EQUAL(0, bean1->getValue());
 
 	// Get a second instance
-	wrapper = creator.create();
-	std::shared_ptr<DummyClass> bean2 = wrapper->m_value;
-	delete(wrapper);
+	std::shared_ptr<DummyClass> bean2 = creator.create();
 	BOOST_CHECK_EQUAL(0, bean2->getValue());
 
 	// Make sure that the two instances are the same
 	BOOST_CHECK_EQUAL(bean1, bean2);
 }
 
+BOOST_AUTO_TEST_CASE(Smart_Singleton_Creator_Per_Instance) {
+	std::weak_ptr<DummyClass> released;
+	{
+		corm::SmartSingletonBeanCreator<DummyClass> creator1;
+		corm::SmartSingletonBeanCreator<DummyClass> creator2;
+
+		// Each creator has its own singleton
+		std::shared_ptr<DummyClass> bean = creator1.create();
+		BOOST_CHECK(bean != creator2.create());
+		BOOST_CHECK_EQUAL(bean, creator1.create());
+		released = bean;
+	}
+
+	// The singleton is let go of along with its creator
+	BOOST_CHECK(released.expired());
+}
+
 
 BOOST_AUTO_TEST_CASE(Smart_Factory_Creator) {
 	corm::SmartFactoryBeanCreator<DummyClass> creator;
 
 	// Get one instance
-	corm::ValueWrapper<std::shared_ptr<DummyClass>>* wrapper = creator.create();
-	std::shared_ptr<DummyClass> bean1 = wrapper->m_value;
-	delete(wrapper);
+	std::shared_ptr<DummyClass> bean1 = creator.create();
 	BOOST_CHECK_EQUAL(0, bean1->getValue());
 
 	// Get a second instance
-	wrapper = creator.create();
-	std::shared_ptr<DummyClass> bean2 = wrapper->m_value;
-	delete(wrapper);
+	std::shared_ptr<DummyClass> bean2 = creator.create();
 	BOOST_CHECK_EQUAL(0, bean2->getValue());
 
 	// Make sure that the two instances are the same
 	BOOST_CHECK(bean1 != bean2);
 }
 
+BOOST_AUTO_TEST_CASE(Scoped_Pointer_Creator) {
+	corm::ScopedBeanCreator<DummyClass*> creator;
+	BOOST_REQUIRE_THROW(creator.create(), corm::NoActiveBeanScopeException);
+
+	DummyClass* first;
+	{
+		corm::BeanScope scope;
+		first = creator.create();
+		BOOST_CHECK_EQUAL(0, first->getValue());
+		first->setValue(5);
+
+		// Verify that it is the same instance within the scope
+		DummyClass* second = creator.create();
+		BOOST_CHECK_EQUAL(first, second);
+		BOOST_CHECK_EQUAL(5, second->getValue());
+
+		// But not within another scope, nor for another creator
+		corm::ScopedBeanCreator<DummyClass*> other;
+		BOOST_CHECK(other.create() != first);
+		{
+			corm::BeanScope inner;
+			BOOST_CHECK(creator.create() != first);
+		}
+		BOOST_CHECK_EQUAL(first, creator.create());
+	}
+	BOOST_REQUIRE_THROW(creator.create(), corm::NoActiveBeanScopeException);
+}
+
+BOOST_AUTO_TEST_CASE(Scoped_Reference_Creator) {
+	corm::ScopedBeanCreator<DummyClass&> creator;
+	corm::BeanScope scope;
+	DummyClass& dummy1 = creator.create();
+	DummyClass& dummy2 = creator.create();
+	BOOST_CHECK_EQUAL(&dummy1, &dummy2);
+}
+
+BOOST_AUTO_TEST_CASE(Scoped_Factory_Pointer_Creator) {
+	corm::ScopedFactoryBeanCreator<DummyClass*> creator;
+	BOOST_REQUIRE_THROW(creator.create(), corm::NoActiveBeanScopeException);
+
+	// No need to delete the instances, the scope takes care of them
+	corm::BeanScope scope;
+	DummyClass* dummy1 = creator.create();
+	DummyClass* dummy2 = creator.create();
+	BOOST_CHECK(dummy1 != dummy2);
+	BOOST_CHECK(dummy1 != NULL);
+	BOOST_CHECK(dummy2 != NULL);
+	BOOST_CHECK_EQUAL(2, scope.size());
+}
+
+BOOST_AUTO_TEST_CASE(Singleton_Pointer_Creator_Concurrent) {
+	for (int race = 0; race < numOfRaces; race++) {
+		numConstructions = 0;
+		corm::SingletonBeanCreator<SlowConstruction*> creator;
+		std::atomic<bool> start(false);
+		std::vector<SlowConstruction*> instances(numOfRacingThreads, NULL);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < numOfRacingThreads; i++) {
+			threads.emplace_back([&creator, &start, &instances, i]() {
+				while (!start.load(std::memory_order_acquire))
+					std::this_thread::yield();
+				instances[i] = creator.create();
+			});
+		}
+		start.store(true, std::memory_order_release);
+		for (std::thread& t: threads)
+			t.join();
+
+		// Exactly one instance, which every thread sees fully constructed
+		BOOST_REQUIRE_EQUAL(1, numConstructions.load());
+		for (SlowConstruction* instance: instances) {
+			BOOST_REQUIRE_EQUAL(instances[0], instance);
+			BOOST_REQUIRE_EQUAL(42, instance->value);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Singleton_Pointer_Creator_Construction_Fails) {
+	corm::SingletonBeanCreator<FailingConstruction*> creator;
+	failConstruction = true;
+	BOOST_REQUIRE_THROW(creator.create(), std::runtime_error);
+
+	// The next request tries again
+	failConstruction = false;
+	FailingConstruction* instance = creator.create();
+	BOOST_CHECK(instance != NULL);
+	BOOST_CHECK_EQUAL(instance, creator.create());
+}
+
+BOOST_AUTO_TEST_CASE(Thread_Local_Pointer_Creator) {
+	numThreadLocalTracked = 0;
+	{
+		corm::ThreadLocalBeanCreator<ThreadLocalTracked*> creator;
+		ThreadLocalTracked* mine = creator.create();
+		mine->value = 5;
+		BOOST_CHECK_EQUAL(mine, creator.create());
+
+		// Every other thread gets its own instance, destroyed along with the thread
+		ThreadLocalTracked* other = NULL;
+		std::thread([&creator, &other]() {
+			other = creator.create();
+			BOOST_CHECK_EQUAL(other, creator.create());
+			BOOST_CHECK_EQUAL(0, other->value);
+			BOOST_CHECK_EQUAL(2, numThreadLocalTracked.load());
+		}).join();
+		BOOST_CHECK(other != mine);
+		BOOST_CHECK_EQUAL(1, numThreadLocalTracked.load());
+		BOOST_CHECK_EQUAL(5, creator.create()->value);
+
+		// As is the instance of a thread outliving the creator, along with the creator
+		corm::ThreadLocalBeanCreator<ThreadLocalTracked*> second;
+		BOOST_CHECK(second.create() != mine);
+		BOOST_CHECK_EQUAL(2, numThreadLocalTracked.load());
+	}
+	BOOST_CHECK_EQUAL(0, numThreadLocalTracked.load());
+
+	// A new creator never picks up the instance of one which ended
+	corm::ThreadLocalBeanCreator<ThreadLocalTracked&> creator;
+	ThreadLocalTracked& instance = creator.create();
+	BOOST_CHECK_EQUAL(0, instance.value);
+	BOOST_CHECK_EQUAL(&instance, &creator.create());
+	BOOST_CHECK_EQUAL(1, numThreadLocalTracked.load());
+}
+
+BOOST_AUTO_TEST_CASE(Thread_Local_Pointer_Creator_Concurrent) {
+	numThreadLocalTracked = 0;
+	corm::ThreadLocalBeanCreator<ThreadLocalTracked*> creator;
+	std::vector<ThreadLocalTracked*> instances(numOfRacingThreads, NULL);
+	std::vector<std::thread> threads;
+	std::atomic<int> numDone(0);
+	std::atomic<bool> release(false);
+	for (int i = 0; i < numOfRacingThreads; i++) {
+		threads.emplace_back([&, i]() {
+			for (int call = 0; call < 1000; call++) {
+				ThreadLocalTracked* instance = creator.create();
+				instance->value++;
+				instances[i] = instance;
+			}
+			// Keep the thread (and so its instance) around until all threads are done
+			numDone.fetch_add(1);
+			while (!release.load())
+				std::this_thread::yield();
+		});
+	}
+	while (numDone.load() < numOfRacingThreads)
+		std::this_thread::yield();
+
+	BOOST_CHECK_EQUAL(numOfRacingThreads, numThreadLocalTracked.load());
+	for (int i = 0; i < numOfRacingThreads; i++) {
+		BOOST_CHECK_EQUAL(1000, instances[i]->value);
+		for (int j = 0; j < i; j++)
+			BOOST_CHECK(instances[i] != instances[j]);
+	}
+	release = true;
+	for (std::thread& t: threads)
+		t.join();
+	BOOST_CHECK_EQUAL(0, numThreadLocalTracked.load());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
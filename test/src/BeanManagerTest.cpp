@@ -5,12 +5,18 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/any.hpp>
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "corm/BeanManager.h"
+#include "CopyCounted.h"
 #include "DummyClass.h"
 
 struct BeanManagerTestCreator {
-	corm::ValueWrapper<DummyClass>* create() {
-		return new corm::ValueWrapper<DummyClass>(135);
+	DummyClass create() {
+		return DummyClass(135);
 	}
 };
 
@@ -28,6 +34,45 @@ class B_depends_on_A {
 	A_depends_on_B* a = sharedManager.getBean<A_depends_on_B*>("A_depends_on_B");
 };
 
+// Classes which form a cycle through a handle resolved ahead of time
+class C_depends_on_D;
+class D_depends_on_C;
+
+corm::BeanRef<C_depends_on_D*> refToC;
+
+class C_depends_on_D {
+	D_depends_on_C* d = sharedManager.getBean<D_depends_on_C*>("D_depends_on_C");
+};
+
+class D_depends_on_C {
+	C_depends_on_D* c = refToC.get();
+};
+
+// Creators which form a long (acyclic) chain of dependent beans, to be used to verify that the cycle detection does not
+// report false positives
+corm::BeanManager chainManager;
+
+template<int N>
+struct ChainCreator {
+	int create() {
+		return chainManager.getBean<int>("chain" + std::to_string(N - 1)) + 1;
+	}
+};
+
+template<>
+struct ChainCreator<0> {
+	int create() {
+		return 0;
+	}
+};
+
+template<int N>
+void registerChain() {
+	if constexpr (N > 0)
+		registerChain<N - 1>();
+	chainManager.registerBean<int, ChainCreator<N>>("chain" + std::to_string(N));
+}
+
 BOOST_AUTO_TEST_SUITE(BeanManager_Test_Suite)
 
 BOOST_AUTO_TEST_CASE(Register_bean_with_no_name) {
@@ -155,6 +200,238 @@ BOOST_AUTO_TEST_CASE(Bean_instance_pointer) {
 	delete(instance);
 }
 
+BOOST_AUTO_TEST_CASE(Bean_instance_registered_without_extra_copies) {
+	corm::BeanManager manager;
+	CopyCounted instance(404);
+
+	// An lvalue is copied exactly once
+	CopyCounted::resetCounts();
+	manager.registerBeanInstance<CopyCounted>("lvalue", instance);
+	BOOST_CHECK_EQUAL(1, CopyCounted::numCopies);
+	BOOST_CHECK_EQUAL(0, CopyCounted::numMoves);
+
+	// An rvalue is moved exactly once (also when the type is deduced)
+	CopyCounted::resetCounts();
+	manager.registerBeanInstance<CopyCounted>("rvalue", std::move(instance));
+	manager.registerBeanInstance("deduced", CopyCounted(505));
+	BOOST_CHECK_EQUAL(0, CopyCounted::numCopies);
+	BOOST_CHECK_EQUAL(2, CopyCounted::numMoves);
+
+	// An emplaced instance is constructed within the manager
+	CopyCounted::resetCounts();
+	manager.emplaceBeanInstance<CopyCounted>("emplaced", 606);
+	BOOST_CHECK_EQUAL(0, CopyCounted::numCopies);
+	BOOST_CHECK_EQUAL(0, CopyCounted::numMoves);
+
+	BOOST_CHECK_EQUAL(404, manager.getBean<const CopyCounted&>("lvalue").getValue());
+	BOOST_CHECK_EQUAL(404, manager.getBean<const CopyCounted&>("rvalue").getValue());
+	BOOST_CHECK_EQUAL(505, manager.getBean<const CopyCounted&>("deduced").getValue());
+	BOOST_CHECK_EQUAL(606, manager.getBean<const CopyCounted&>("emplaced").getValue());
+	BOOST_REQUIRE_THROW(manager.emplaceBeanInstance<CopyCounted>("emplaced", 707), corm::InvalidBeanNameException);
+}
+
+BOOST_AUTO_TEST_CASE(Bean_instance_type_deduced_as_by_value) {
+	corm::BeanManager manager;
+	const int constant = 808;
+
+	// As when passed by value, an array decays to a pointer and a const scalar is registered without the const
+	manager.registerBeanInstance("greeting", "hello");
+	manager.registerBeanInstance("constant", constant);
+	BOOST_CHECK_EQUAL(std::string("hello"), manager.getBean<const char*>("greeting"));
+	BOOST_CHECK_EQUAL(808, manager.getBean<int>("constant"));
+}
+
+BOOST_AUTO_TEST_CASE(Bean_instance_const_reference) {
+	corm::BeanManager manager;
+	manager.registerBeanInstance<CopyCounted>("instance_scalar", CopyCounted(303));
+	manager.registerBean<CopyCounted, corm::FactoryBeanCreator<CopyCounted>>("factory_scalar");
+	manager.registerBean<const DummyClass&>("singleton_const_reference");
+	CopyCounted::resetCounts();
+
+	// The scalar instance is referred to, rather than copied
+	const CopyCounted& bean = manager.getBean<const CopyCounted&>("instance_scalar");
+	BOOST_CHECK_EQUAL(303, bean.getValue());
+	BOOST_CHECK_EQUAL(&bean, &manager.getBean<const CopyCounted&>("instance_scalar"));
+	BOOST_CHECK_EQUAL(0, CopyCounted::numCopies);
+	BOOST_CHECK_EQUAL(303, manager.getBean<CopyCounted>("instance_scalar").getValue());
+	BOOST_CHECK_EQUAL(1, CopyCounted::numCopies);
+
+	// The type is still checked, and a factory creates a new bean each time so it cannot be referred to
+	BOOST_REQUIRE_THROW(manager.getBean<const DummyClass&>("instance_scalar"), corm::InvalidBeanTypeException);
+	BOOST_REQUIRE_THROW(manager.getBean<const CopyCounted&>("factory_scalar"), corm::InvalidBeanTypeException);
+
+	// A bean registered as a const reference is retrieved as before
+	const DummyClass& singleton = manager.getBean<const DummyClass&>("singleton_const_reference");
+	BOOST_CHECK_EQUAL(&singleton, &manager.getBean<const DummyClass&>("singleton_const_reference"));
+}
+
+BOOST_AUTO_TEST_CASE(Unique_pointer_factory) {
+	corm::BeanManager manager;
+	manager.registerBean<std::unique_ptr<DummyClass>, corm::SmartFactoryBeanCreator<DummyClass, std::unique_ptr>>("unique_factory");
+
+	// Each retrieval hands over the ownership of a new instance
+	std::unique_ptr<DummyClass> bean1 = manager.getBean<std::unique_ptr<DummyClass>>("unique_factory");
+	std::unique_ptr<DummyClass> bean2 = manager.getBeanRef<std::unique_ptr<DummyClass>>("unique_factory").get();
+	BOOST_REQUIRE(bean1 != NULL);
+	BOOST_REQUIRE(bean2 != NULL);
+	BOOST_CHECK(bean1 != bean2);
+	BOOST_CHECK_EQUAL(0, bean1->getValue());
+}
+
+BOOST_AUTO_TEST_CASE(Move_only_value_bean) {
+	corm::BeanManager manager;
+	manager.registerBean<MoveOnly, corm::FactoryBeanCreator<MoveOnly>>("move_only");
+
+	MoveOnly bean = manager.getBean<MoveOnly>("move_only");
+	BOOST_CHECK_EQUAL(0, bean.getValue());
+	BOOST_CHECK_EQUAL(0, manager.getBeanRef<MoveOnly>("move_only")().getValue());
+}
+
+BOOST_AUTO_TEST_CASE(Value_bean_is_not_copied) {
+	corm::BeanManager manager;
+	manager.registerBean<CopyCounted, corm::FactoryBeanCreator<CopyCounted>>("copy_counted");
+	CopyCounted::resetCounts();
+
+	// Passed from the creator to the caller without a single copy, whether or not the statistics are counted
+	const bool statistics = corm::BeanStatistics::isEnabled();
+	for (bool enabled: {false, true}) {
+		corm::BeanStatistics::setEnabled(enabled);
+		CopyCounted bean = manager.getBean<CopyCounted>("copy_counted");
+		BOOST_CHECK_EQUAL(0, bean.getValue());
+		manager.getBeanRef<CopyCounted>("copy_counted").get();
+	}
+	corm::BeanStatistics::setEnabled(statistics);
+	BOOST_CHECK_EQUAL(0, CopyCounted::numCopies);
+}
+
+BOOST_AUTO_TEST_CASE(Bean_ref_singleton_pointer) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*>("ref_singleton_pointer");
+
+	corm::BeanRef<DummyClass*> ref = manager.getBeanRef<DummyClass*>("ref_singleton_pointer");
+	BOOST_CHECK(ref.isResolved());
+	BOOST_CHECK_EQUAL(ref.get(), ref());
+	BOOST_CHECK_EQUAL(manager.getBean<DummyClass*>("ref_singleton_pointer"), ref.get());
+}
+
+BOOST_AUTO_TEST_CASE(Bean_ref_factory_scalar) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass, BeanManagerTestCreator>("ref_factory_scalar");
+
+	// The handle can also be resolved through getBean
+	corm::BeanRef<DummyClass> ref = manager.getBean<corm::BeanRef<DummyClass>>("ref_factory_scalar");
+	BOOST_CHECK_EQUAL(135, ref.get().getValue());
+	BOOST_CHECK_EQUAL(135, ref().getValue());
+}
+
+BOOST_AUTO_TEST_CASE(Bean_ref_invalid) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*>("ref_wrong_type");
+
+	BOOST_CHECK(!corm::BeanRef<int>().isResolved());
+	BOOST_REQUIRE_THROW(manager.getBeanRef<int>("ref_wrong_type"), corm::InvalidBeanTypeException);
+#ifndef ENABLE_BEAN_AUTOREGISTRATION
+	BOOST_REQUIRE_THROW(manager.getBeanRef<int>("ref_does_not_exist"), corm::InvalidBeanNameException);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(Frozen_manager) {
+	corm::BeanManager manager;
+	DummyClass instance(303);
+	manager.registerBean<DummyClass*>("frozen_singleton");
+	manager.registerBean<DummyClass, BeanManagerTestCreator>("frozen_factory");
+	manager.registerBeanInstance<DummyClass&>("frozen_instance", instance);
+	DummyClass* singleton = manager.getBean<DummyClass*>("frozen_singleton");
+	corm::BeanRef<DummyClass*> ref = manager.getBeanRef<DummyClass*>("frozen_singleton");
+
+	BOOST_CHECK(!manager.isFrozen());
+	manager.freeze();
+	BOOST_CHECK(manager.isFrozen());
+	// Freezing again has no effect
+	manager.freeze();
+	BOOST_CHECK(manager.isFrozen());
+
+	// The beans (and handles) remain the same
+	BOOST_CHECK_EQUAL(singleton, manager.getBean<DummyClass*>("frozen_singleton"));
+	BOOST_CHECK_EQUAL(singleton, ref.get());
+	BOOST_CHECK_EQUAL(135, manager.getBean<DummyClass>("frozen_factory").getValue());
+	BOOST_CHECK_EQUAL(&instance, &manager.getBean<DummyClass&>("frozen_instance"));
+	BOOST_CHECK(manager.containsBean("frozen_factory"));
+	BOOST_CHECK(!manager.containsBean("frozen_missing"));
+	BOOST_REQUIRE_THROW(manager.getBean<int>("frozen_singleton"), corm::InvalidBeanTypeException);
+
+	// No bean can be registered anymore, whether or not its name is taken
+	BOOST_REQUIRE_THROW(manager.registerBean<DummyClass*>("frozen_new"), corm::BeanManagerFrozenException);
+	BOOST_REQUIRE_THROW(manager.registerBeanInstance<int>("frozen_singleton", 1), corm::BeanManagerFrozenException);
+	BOOST_CHECK(!manager.containsBean("frozen_new"));
+#ifdef ENABLE_BEAN_AUTOREGISTRATION
+	BOOST_REQUIRE_THROW(manager.getBean<DummyClass*>("frozen_missing"), corm::BeanManagerFrozenException);
+#else
+	BOOST_REQUIRE_THROW(manager.getBean<DummyClass*>("frozen_missing"), corm::InvalidBeanNameException);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(Frozen_empty_manager) {
+	corm::BeanManager manager;
+	manager.freeze();
+	BOOST_CHECK(!manager.containsBean(""));
+	BOOST_CHECK(!manager.containsBean("anything"));
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent_lookup_and_registration) {
+	const int numReaders = 4;
+	const int numBeans = 2000;
+	corm::BeanManager manager;
+	DummyClass instance(42);
+	manager.registerBeanInstance<DummyClass*>("shared", &instance);
+
+	// Readers continuously retrieve the shared bean, while the writer registers (late) beans, growing the registry
+	std::atomic<bool> done(false);
+	std::atomic<int> numFailures(0);
+	std::vector<std::thread> readers;
+	for (int t = 0; t < numReaders; t++) {
+		readers.emplace_back([&manager, &done, &numFailures, &instance]() {
+			while (!done.load()) {
+				if (manager.getBean<DummyClass*>("shared") != &instance)
+					numFailures++;
+			}
+		});
+	}
+
+	for (int i = 0; i < numBeans; i++)
+		manager.registerBeanInstance<int>("late" + std::to_string(i), i);
+	done = true;
+	for (std::thread& t: readers)
+		t.join();
+
+	BOOST_CHECK_EQUAL(0, numFailures.load());
+	for (int i = 0; i < numBeans; i++)
+		BOOST_CHECK_EQUAL(i, manager.getBean<int>("late" + std::to_string(i)));
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent_registration_of_same_name) {
+	const int numWriters = 4;
+	corm::BeanManager manager;
+
+	// Only one of the writers may successfully register the bean
+	std::atomic<int> numRegistered(0);
+	std::vector<std::thread> writers;
+	for (int t = 0; t < numWriters; t++) {
+		writers.emplace_back([&manager, &numRegistered, t]() {
+			try {
+				manager.registerBeanInstance<int>("contested", t);
+				numRegistered++;
+			} catch (corm::InvalidBeanNameException&) {
+			}
+		});
+	}
+	for (std::thread& t: writers)
+		t.join();
+
+	BOOST_CHECK_EQUAL(1, numRegistered.load());
+	BOOST_CHECK(manager.containsBean("contested"));
+}
+
 BOOST_AUTO_TEST_CASE(Check_for_Cyclic_Bean_Dependencies) {
 	// Register the two beans (will not get created until requested)
 	sharedManager.registerBean<A_depends_on_B*>("A_depends_on_B");
@@ -162,6 +439,89 @@ BOOST_AUTO_TEST_CASE(Check_for_Cyclic_Bean_Dependencies) {
 
 	BOOST_REQUIRE_THROW(sharedManager.getBean<A_depends_on_B*>("A_depends_on_B"), corm::BeanDependencyCycleException);
 	BOOST_REQUIRE_THROW(sharedManager.getBean<B_depends_on_A*>("B_depends_on_A"), corm::BeanDependencyCycleException);
+
+	// The full chain must be reported
+	try {
+		sharedManager.getBean<A_depends_on_B*>("A_depends_on_B");
+		BOOST_FAIL("Cycle was not detected");
+	} catch (corm::BeanDependencyCycleException& e) {
+		BOOST_CHECK_EQUAL("Dependency cycle detected [A_depends_on_B, B_depends_on_A, A_depends_on_B]", e.what());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Check_for_Cyclic_Bean_Dependencies_through_BeanRef) {
+	sharedManager.registerBean<C_depends_on_D*>("C_depends_on_D");
+	sharedManager.registerBean<D_depends_on_C*>("D_depends_on_C");
+	refToC = sharedManager.getBeanRef<C_depends_on_D*>("C_depends_on_D");
+
+	// The handle must be tracked the same as a lookup by name, rather than recursing until the stack overflows
+	try {
+		refToC.get();
+		BOOST_FAIL("Cycle was not detected");
+	} catch (corm::BeanDependencyCycleException& e) {
+		BOOST_CHECK_EQUAL("Dependency cycle detected [C_depends_on_D, D_depends_on_C, C_depends_on_D]", e.what());
+	}
+	BOOST_REQUIRE_THROW(sharedManager.getBean<D_depends_on_C*>("D_depends_on_C"), corm::BeanDependencyCycleException);
+}
+
+BOOST_AUTO_TEST_CASE(Long_Chain_Is_Not_A_Cycle) {
+	// The chain is longer than the number of "in progress" markers, so some of the beans must share a marker
+	registerChain<100>();
+	BOOST_CHECK_EQUAL(100, chainManager.getBean<int>("chain100"));
+	BOOST_CHECK_EQUAL(50, chainManager.getBean<int>("chain50"));
+}
+
+BOOST_AUTO_TEST_CASE(Child_Falls_Back_To_Parent) {
+	corm::BeanManager parent;
+	parent.registerBean<DummyClass*>("parent_singleton");
+	parent.registerBeanInstance<int>("shared_value", 5);
+	parent.freeze();
+
+	corm::BeanManager child(&parent);
+	BOOST_CHECK_EQUAL(&parent, child.getParent());
+	BOOST_CHECK(parent.getParent() == NULL);
+	child.registerBeanInstance<int>("child_value", 7);
+
+	// The beans of the parent are shared rather than copied
+	BOOST_CHECK_EQUAL(parent.getBean<DummyClass*>("parent_singleton"), child.getBean<DummyClass*>("parent_singleton"));
+	BOOST_CHECK_EQUAL(5, child.getBeanRef<int>("shared_value").get());
+	BOOST_CHECK_EQUAL(7, child.getBean<int>("child_value"));
+	BOOST_CHECK(child.containsBean("shared_value"));
+	BOOST_REQUIRE_THROW(child.getBean<double>("shared_value"), corm::InvalidBeanTypeException);
+
+	// While the parent knows nothing of the beans of the child
+	BOOST_CHECK(!parent.containsBean("child_value"));
+	BOOST_CHECK_EQUAL(1, child.getStatistics().size());
+}
+
+BOOST_AUTO_TEST_CASE(Child_Cannot_Shadow_Parent) {
+	corm::BeanManager parent;
+	parent.registerBeanInstance<int>("taken_by_parent", 1);
+
+	corm::BeanManager child(&parent);
+	BOOST_REQUIRE_THROW(child.registerBeanInstance<int>("taken_by_parent", 2), corm::InvalidBeanNameException);
+	BOOST_CHECK_EQUAL(1, child.getBean<int>("taken_by_parent"));
+
+#ifdef ENABLE_BEAN_AUTOREGISTRATION
+	// Auto registered beans belong to the child
+	DummyClass* autoBean = child.getBean<DummyClass*>("auto_registered_by_child");
+	BOOST_CHECK(autoBean != NULL);
+	BOOST_CHECK(!parent.containsBean("auto_registered_by_child"));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(Grandchild_Falls_Back_Through_Chain) {
+	corm::BeanManager root;
+	root.registerBeanInstance<int>("root_value", 1);
+	corm::BeanManager child(&root);
+	child.registerBeanInstance<int>("child_value", 2);
+	corm::BeanManager grandchild(&child);
+
+	BOOST_CHECK_EQUAL(1, grandchild.getBean<int>("root_value"));
+	BOOST_CHECK_EQUAL(2, grandchild.getBean<int>("child_value"));
+#ifndef ENABLE_BEAN_AUTOREGISTRATION
+	BOOST_REQUIRE_THROW(grandchild.getBean<int>("in_no_manager"), corm::InvalidBeanNameException);
+#endif
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "corm/BeanManager.h"
+#include "corm/BeanPool.h"
+#include "DummyClass.h"
+
+// Number of PoolTracked that currently exist
+static std::atomic<int> numPoolTracked(0);
+
+/*
+ * Bean which tracks how many instances exist.
+ */
+struct PoolTracked {
+	PoolTracked() {
+		numPoolTracked.fetch_add(1);
+	}
+	~PoolTracked() {
+		numPoolTracked.fetch_sub(1);
+	}
+
+	int value = 0;
+};
+
+/*
+ * Reset hook which clears the value, refusing negative values.
+ */
+static void resetPoolTracked(PoolTracked& bean) {
+	if (bean.value < 0)
+		throw std::runtime_error("cannot reset");
+	bean.value = 0;
+}
+
+BOOST_AUTO_TEST_SUITE(BeanPool_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Instances_Recycled) {
+	numPoolTracked = 0;
+	{
+		corm::BeanPool<PoolTracked> pool(4);
+		BOOST_CHECK_EQUAL(4, pool.getCapacity());
+
+		PoolTracked* first;
+		{
+			corm::PooledBean<PoolTracked> bean = pool.acquire();
+			first = bean.get();
+			bean->value = 5;
+			BOOST_CHECK_EQUAL(&pool, bean.getPool());
+		}
+		BOOST_CHECK_EQUAL(0, pool.getHits());
+		BOOST_CHECK_EQUAL(1, pool.getMisses());
+
+		// The same instance is handed out again, as it was left (there being no reset hook)
+		corm::PooledBean<PoolTracked> bean = pool.acquire();
+		BOOST_CHECK_EQUAL(first, bean.get());
+		BOOST_CHECK_EQUAL(5, (*bean).value);
+		BOOST_CHECK_EQUAL(1, pool.getHits());
+		BOOST_CHECK_EQUAL(1, numPoolTracked.load());
+
+		// Release explicitly, after which the handle is empty
+		bean.release();
+		BOOST_CHECK(bean.get() == NULL);
+		bean.release();
+		BOOST_CHECK_EQUAL(1, numPoolTracked.load());
+	}
+	BOOST_CHECK_EQUAL(0, numPoolTracked.load());
+}
+
+BOOST_AUTO_TEST_CASE(Capacity_Bounded) {
+	numPoolTracked = 0;
+	corm::BeanPool<PoolTracked> pool(3);
+	BOOST_CHECK_EQUAL(4, pool.getCapacity());
+	{
+		std::vector<corm::PooledBean<PoolTracked>> beans;
+		for (int i = 0; i < 6; i++)
+			beans.push_back(pool.acquire());
+		BOOST_CHECK_EQUAL(6, pool.getMisses());
+		BOOST_CHECK_EQUAL(6, numPoolTracked.load());
+	}
+
+	// Only as many as fit within the pool are kept
+	BOOST_CHECK_EQUAL(2, pool.getDiscards());
+	BOOST_CHECK_EQUAL(4, numPoolTracked.load());
+}
+
+BOOST_AUTO_TEST_CASE(Capacity_Of_One) {
+	numPoolTracked = 0;
+	corm::BeanPool<PoolTracked> pool(1);
+	BOOST_CHECK_EQUAL(1, pool.getCapacity());
+	{
+		corm::PooledBean<PoolTracked> first = pool.acquire();
+		corm::PooledBean<PoolTracked> second = pool.acquire();
+	}
+
+	// A single instance is kept, and handed out again
+	BOOST_CHECK_EQUAL(1, pool.getDiscards());
+	BOOST_CHECK_EQUAL(1, numPoolTracked.load());
+	for (int i = 0; i < 3; i++)
+		pool.acquire();
+	BOOST_CHECK_EQUAL(3, pool.getHits());
+	BOOST_CHECK_EQUAL(2, pool.getMisses());
+	BOOST_CHECK_EQUAL(1, numPoolTracked.load());
+}
+
+BOOST_AUTO_TEST_CASE(Reset_Hook) {
+	numPoolTracked = 0;
+	corm::BeanPool<PoolTracked> pool(2, &resetPoolTracked);
+	pool.acquire()->value = 7;
+	BOOST_CHECK_EQUAL(0, pool.acquire()->value);
+
+	// An instance which cannot be reset is not kept
+	pool.acquire()->value = -1;
+	BOOST_CHECK_EQUAL(1, pool.getDiscards());
+	BOOST_CHECK_EQUAL(0, numPoolTracked.load());
+}
+
+BOOST_AUTO_TEST_CASE(Handles_Moved) {
+	corm::BeanPool<PoolTracked> pool(2);
+	corm::PooledBean<PoolTracked> first = pool.acquire();
+	PoolTracked* instance = first.get();
+
+	corm::PooledBean<PoolTracked> second(std::move(first));
+	BOOST_CHECK(first.get() == NULL);
+	BOOST_CHECK_EQUAL(instance, second.get());
+
+	// Assigning returns the instance which was held
+	corm::PooledBean<PoolTracked> third = pool.acquire();
+	third = std::move(second);
+	BOOST_CHECK_EQUAL(instance, third.get());
+	BOOST_CHECK_EQUAL(0, pool.getDiscards());
+	BOOST_CHECK_EQUAL(0, pool.getHits());
+	pool.acquire();
+	BOOST_CHECK_EQUAL(1, pool.getHits());
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent_Acquire_And_Release) {
+	numPoolTracked = 0;
+	const int numThreads = 8;
+	const int numCalls = 5000;
+	{
+		corm::BeanPool<PoolTracked> pool(4, &resetPoolTracked);
+		std::atomic<int> numShared(0);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < numThreads; t++) {
+			threads.emplace_back([&pool, &numShared]() {
+				for (int i = 0; i < numCalls; i++) {
+					corm::PooledBean<PoolTracked> bean = pool.acquire();
+					// No other thread may hold the same instance at the same time
+					if (bean->value != 0)
+						numShared.fetch_add(1);
+					bean->value = i + 1;
+				}
+			});
+		}
+		for (std::thread& t: threads)
+			t.join();
+
+		BOOST_CHECK_EQUAL(0, numShared.load());
+		BOOST_CHECK_EQUAL(numThreads * numCalls, pool.getHits() + pool.getMisses());
+		BOOST_CHECK_EQUAL(pool.getMisses() - pool.getDiscards(), numPoolTracked.load());
+		BOOST_CHECK(numPoolTracked.load() <= 4);
+	}
+	BOOST_CHECK_EQUAL(0, numPoolTracked.load());
+}
+
+BOOST_AUTO_TEST_CASE(Pooled_Beans_Through_Manager) {
+	corm::BeanManager manager;
+	manager.registerBean<corm::PooledBean<DummyClass>, corm::PooledBeanCreator<DummyClass>>("pooled");
+
+	DummyClass* instance;
+	corm::BeanPool<DummyClass>* pool;
+	{
+		corm::PooledBean<DummyClass> bean = manager.getBean<corm::PooledBean<DummyClass>>("pooled");
+		instance = bean.get();
+		pool = bean.getPool();
+	}
+	BOOST_CHECK_EQUAL(instance, manager.getBean<corm::PooledBean<DummyClass>>("pooled").get());
+	BOOST_CHECK_EQUAL(instance, manager.getBeanRef<corm::PooledBean<DummyClass>>("pooled").get().get());
+	BOOST_CHECK_EQUAL(64, pool->getCapacity());
+	BOOST_CHECK_EQUAL(1, pool->getMisses());
+	BOOST_CHECK_EQUAL(2, pool->getHits());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
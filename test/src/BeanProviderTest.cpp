@@ -8,8 +8,8 @@
 #include "DummyClass.h"
 
 struct BeanProviderTestCreator {
-	corm::ValueWrapper<DummyClass>* create() {
-		return new corm::ValueWrapper<DummyClass>(DummyClass(789));
+	DummyClass create() {
+		return DummyClass(789);
 	}
 };
 
@@ -71,4 +71,27 @@ BOOST_AUTO_TEST_CASE(Bean_instance_provider) {
 	BOOST_CHECK_EQUAL(&instance, bean);
 }
 
+BOOST_AUTO_TEST_CASE(Provider_type_tag) {
+	corm::BeanInstanceProvider<int> scalarProvider(1);
+	corm::BeanCreatorProvider<int&, corm::SingletonBeanCreator<int&>> referenceProvider;
+	corm::BeanCreatorProvider<int*, corm::SingletonBeanCreator<int*>> pointerProvider;
+
+	// The tag must match for the same type, regardless of how the bean is provided
+	BOOST_CHECK(corm::typeTag<int>() == scalarProvider.getTypeTag());
+	BOOST_CHECK(corm::typeTag<int&>() == referenceProvider.getTypeTag());
+	BOOST_CHECK(corm::typeTag<int*>() == pointerProvider.getTypeTag());
+
+	// And differ for every other type
+	BOOST_CHECK(corm::typeTag<int>() != corm::typeTag<int&>());
+	BOOST_CHECK(corm::typeTag<int>() != corm::typeTag<const int>());
+	BOOST_CHECK(corm::typeTag<int*>() != corm::typeTag<const int*>());
+	BOOST_CHECK(corm::typeTag<int*>() != corm::typeTag<DummyClass*>());
+}
+
+BOOST_AUTO_TEST_CASE(Provider_type_name) {
+	corm::BeanInstanceProvider<int*> provider(NULL);
+	BOOST_CHECK(provider.getType().find("int") != std::string::npos);
+	BOOST_CHECK(corm::typeName<DummyClass&>().find("DummyClass") != std::string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "corm/BeanRegistry.h"
+#include "DummyClass.h"
+
+BOOST_AUTO_TEST_SUITE(BeanRegistry_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Empty_registry) {
+	corm::BeanRegistry registry;
+	BOOST_CHECK_EQUAL(0, registry.size());
+	BOOST_CHECK(registry.find("bean") == NULL);
+	BOOST_CHECK(registry.find("") == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(Insert_and_find) {
+	corm::BeanRegistry registry;
+	corm::BeanInstanceProvider<int> provider(5);
+	BOOST_CHECK(registry.insert("bean", &provider));
+	BOOST_CHECK_EQUAL(1, registry.size());
+
+	// Lookup through all of the supported key types
+	std::string name = "bean";
+	std::string_view view = name;
+	BOOST_CHECK_EQUAL(&provider, registry.find(name));
+	BOOST_CHECK_EQUAL(&provider, registry.find(view));
+	BOOST_CHECK_EQUAL(&provider, registry.find("bean"));
+
+	// Similar names must not match
+	BOOST_CHECK(registry.find("bea") == NULL);
+	BOOST_CHECK(registry.find("beans") == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(Insert_duplicate) {
+	corm::BeanRegistry registry;
+	corm::BeanInstanceProvider<int> provider1(1);
+	corm::BeanInstanceProvider<int> provider2(2);
+	BOOST_CHECK(registry.insert("bean", &provider1));
+	BOOST_CHECK(!registry.insert("bean", &provider2));
+
+	// The original must remain
+	BOOST_CHECK_EQUAL(1, registry.size());
+	BOOST_CHECK_EQUAL(&provider1, registry.find("bean"));
+}
+
+BOOST_AUTO_TEST_CASE(Insert_many) {
+	const int numBeans = 5000;
+	corm::BeanRegistry registry;
+	std::vector<corm::BeanInstanceProvider<int>*> providers;
+	for (int i = 0; i < numBeans; i++) {
+		providers.push_back(new corm::BeanInstanceProvider<int>(i));
+		BOOST_REQUIRE(registry.insert("bean" + std::to_string(i), providers.back()));
+	}
+	BOOST_CHECK_EQUAL(numBeans, registry.size());
+
+	// Every bean must still be found after the table has grown multiple times
+	for (int i = 0; i < numBeans; i++)
+		BOOST_CHECK_EQUAL(providers[i], registry.find("bean" + std::to_string(i)));
+	BOOST_CHECK(registry.find("bean" + std::to_string(numBeans)) == NULL);
+
+	// Each bean must be visited exactly once
+	int numVisited = 0;
+	registry.forEach([&numVisited](const std::string&, corm::BaseProvider*) { numVisited++; });
+	BOOST_CHECK_EQUAL(numBeans, numVisited);
+
+	for (corm::BeanInstanceProvider<int>* p: providers)
+		delete(p);
+}
+
+BOOST_AUTO_TEST_CASE(Freeze) {
+	corm::BeanRegistry registry;
+	corm::BeanInstanceProvider<int> provider1(1);
+	corm::BeanInstanceProvider<int> provider2(2);
+	BOOST_CHECK(registry.insert("bean1", &provider1));
+	BOOST_CHECK(!registry.isFrozen());
+
+	registry.freeze();
+	BOOST_CHECK(registry.isFrozen());
+	BOOST_CHECK_EQUAL(&provider1, registry.find("bean1"));
+	BOOST_CHECK(registry.find("bean2") == NULL);
+
+	// Nothing more can be inserted
+	BOOST_CHECK(!registry.insert("bean2", &provider2));
+	BOOST_CHECK_EQUAL(1, registry.size());
+	BOOST_CHECK(registry.find("bean2") == NULL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "corm/BeanManager.h"
+#include "corm/BeanScope.h"
+#include "DummyClass.h"
+
+// The order in which the ScopeTracked beans were destroyed
+static std::vector<int> destroyed;
+
+/*
+ * Bean which records its destruction.
+ */
+class ScopeTracked {
+public:
+	ScopeTracked(): m_id(s_nextId++) {}
+	~ScopeTracked() {
+		destroyed.push_back(m_id);
+	}
+
+	int getId() const {
+		return m_id;
+	}
+
+	static int s_nextId;
+
+private:
+	int m_id;
+	// Large enough that a handful of beans outgrow the arena within the scope
+	char m_payload[200];
+};
+
+int ScopeTracked::s_nextId = 0;
+
+BOOST_AUTO_TEST_SUITE(BeanScope_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Scope_Is_Active_Within_Thread) {
+	BOOST_CHECK(corm::BeanScope::current() == NULL);
+	BOOST_REQUIRE_THROW(corm::BeanScope::requireCurrent(), corm::NoActiveBeanScopeException);
+	{
+		corm::BeanScope outer;
+		BOOST_CHECK_EQUAL(&outer, corm::BeanScope::current());
+		{
+			corm::BeanScope inner;
+			BOOST_CHECK_EQUAL(&inner, &corm::BeanScope::requireCurrent());
+		}
+		BOOST_CHECK_EQUAL(&outer, corm::BeanScope::current());
+	}
+	BOOST_CHECK(corm::BeanScope::current() == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(Beans_Released_With_Scope) {
+	destroyed.clear();
+	ScopeTracked::s_nextId = 0;
+	{
+		corm::BeanScope scope;
+		for (int i = 0; i < 10; i++)
+			BOOST_CHECK_EQUAL(i, scope.create<ScopeTracked>()->getId());
+		BOOST_CHECK_EQUAL(10, scope.size());
+		BOOST_CHECK(destroyed.empty());
+	}
+
+	// Destroyed in the reverse order of creation
+	BOOST_REQUIRE_EQUAL(10, destroyed.size());
+	for (int i = 0; i < 10; i++)
+		BOOST_CHECK_EQUAL(9 - i, destroyed[i]);
+}
+
+BOOST_AUTO_TEST_CASE(Scope_Reset) {
+	destroyed.clear();
+	corm::BeanScope scope;
+	int key;
+	ScopeTracked* first = scope.getInstance<ScopeTracked>(&key);
+	BOOST_CHECK_EQUAL(first, scope.getInstance<ScopeTracked>(&key));
+	BOOST_CHECK_EQUAL(1, scope.size());
+
+	// The scope can be reused for the next unit of work
+	scope.reset();
+	BOOST_CHECK_EQUAL(1, destroyed.size());
+	BOOST_CHECK_EQUAL(0, scope.size());
+	ScopeTracked* second = scope.getInstance<ScopeTracked>(&key);
+	BOOST_CHECK(second->getId() != destroyed[0]);
+	BOOST_CHECK_EQUAL(&scope, corm::BeanScope::current());
+}
+
+BOOST_AUTO_TEST_CASE(Scoped_Beans_Through_Manager) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*, corm::ScopedBeanCreator<DummyClass*>>("requestSingleton");
+	manager.registerBean<DummyClass*, corm::ScopedFactoryBeanCreator<DummyClass*>>("requestFactory");
+	BOOST_REQUIRE_THROW(manager.getBean<DummyClass*>("requestSingleton"), corm::NoActiveBeanScopeException);
+
+	for (int request = 0; request < 3; request++) {
+		corm::BeanScope scope;
+		DummyClass* singleton = manager.getBean<DummyClass*>("requestSingleton");
+		BOOST_CHECK_EQUAL(0, singleton->getValue());
+		singleton->setValue(request + 1);
+		BOOST_CHECK_EQUAL(singleton, manager.getBean<DummyClass*>("requestSingleton"));
+		BOOST_CHECK(manager.getBean<DummyClass*>("requestFactory") != manager.getBean<DummyClass*>("requestFactory"));
+		BOOST_CHECK_EQUAL(3, scope.size());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
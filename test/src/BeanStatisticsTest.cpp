@@ -0,0 +1,257 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "corm/BeanManager.h"
+#include "DummyClass.h"
+
+/*
+ * Fixture which enables the statistics for the duration of a test.
+ */
+struct StatisticsEnabled {
+	StatisticsEnabled() { corm::BeanStatistics::setEnabled(true); }
+	~StatisticsEnabled() { corm::BeanStatistics::setEnabled(false); }
+};
+
+/*
+ * Helper which finds the statistics of the bean within the snapshot.
+ */
+static const corm::BeanStatisticsEntry& findEntry(const std::vector<corm::BeanStatisticsEntry>& statistics,
+		const std::string& name) {
+	for (const corm::BeanStatisticsEntry& e: statistics) {
+		if (e.name == name)
+			return e;
+	}
+	BOOST_FAIL("No statistics for " + name);
+	return statistics.front();
+}
+
+/*
+ * Creator which reuses each instance for three retrievals, before constructing the next one.
+ */
+struct EveryThirdCreator {
+	static constexpr bool reusesInstance = true;
+
+	DummyClass* create() {
+		return create(corm::DirectConstruction());
+	}
+
+	template<class Observer>
+	DummyClass* create(Observer observe) {
+		if (m_retrievals++ % 3 == 0)
+			m_instances.emplace_back(observe([]() { return new DummyClass(); }));
+		return m_instances.back().get();
+	}
+
+private:
+	std::vector<std::unique_ptr<DummyClass>> m_instances;
+	int m_retrievals = 0;
+};
+
+// The number of times that constructing a FailsAtFirst is yet to fail
+static int numFailuresLeft = 0;
+
+/*
+ * Bean of which the construction fails for as long as numFailuresLeft remains.
+ */
+struct FailsAtFirst {
+	FailsAtFirst() {
+		if (numFailuresLeft > 0) {
+			numFailuresLeft--;
+			throw std::runtime_error("construction failed");
+		}
+	}
+};
+
+BOOST_AUTO_TEST_SUITE(BeanStatistics_Test_Suite)
+
+BOOST_FIXTURE_TEST_CASE(Counted_When_Enabled, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*>("singleton");
+	manager.registerBean<DummyClass*, corm::FactoryBeanCreator<DummyClass*>>("factory");
+	manager.registerBeanInstance<int>("instance", 123);
+
+	manager.getBean<DummyClass*>("singleton");
+	manager.getBean<DummyClass*>("singleton");
+	BOOST_REQUIRE_THROW(manager.getBean<int>("singleton"), corm::InvalidBeanTypeException);
+	for (int i = 0; i < 3; i++)
+		delete(manager.getBean<DummyClass*>("factory"));
+	manager.getBean<int>("instance");
+
+	const std::vector<corm::BeanStatisticsEntry> statistics = manager.getStatistics();
+	BOOST_REQUIRE_EQUAL(3u, statistics.size());
+	// Sorted by name
+	BOOST_CHECK_EQUAL("factory", statistics[0].name);
+	BOOST_CHECK_EQUAL("instance", statistics[1].name);
+	BOOST_CHECK_EQUAL("singleton", statistics[2].name);
+
+	const corm::BeanStatisticsEntry& singleton = findEntry(statistics, "singleton");
+	const corm::BeanStatisticsEntry& factory = findEntry(statistics, "factory");
+	const corm::BeanStatisticsEntry& instance = findEntry(statistics, "instance");
+#ifndef DISABLE_CORM_STATISTICS
+	BOOST_CHECK_EQUAL(2u, singleton.lookups);
+	BOOST_CHECK_EQUAL(1u, singleton.typeMismatches);
+	// A singleton is only created once
+	BOOST_CHECK_EQUAL(1u, singleton.creations);
+	BOOST_CHECK_EQUAL(3u, factory.lookups);
+	BOOST_CHECK_EQUAL(0u, factory.typeMismatches);
+	BOOST_CHECK_EQUAL(3u, factory.creations);
+	BOOST_CHECK(factory.creationTime.count() > 0);
+	BOOST_CHECK_EQUAL(1u, instance.lookups);
+	// An instance is never created
+	BOOST_CHECK_EQUAL(0u, instance.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, singleton.lookups + singleton.typeMismatches + singleton.creations);
+	BOOST_CHECK_EQUAL(0u, factory.lookups + factory.typeMismatches + factory.creations);
+	BOOST_CHECK_EQUAL(0u, instance.lookups);
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(Counted_Through_Handle, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*, corm::FactoryBeanCreator<DummyClass*>>("factory");
+	corm::BeanRef<DummyClass*> ref = manager.getBeanRef<DummyClass*>("factory");
+	delete(ref.get());
+	delete(ref.get());
+
+	const corm::BeanStatisticsEntry factory = findEntry(manager.getStatistics(), "factory");
+#ifndef DISABLE_CORM_STATISTICS
+	// A single lookup to resolve the handle, after which the creations are still counted
+	BOOST_CHECK_EQUAL(1u, factory.lookups);
+	BOOST_CHECK_EQUAL(2u, factory.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, factory.lookups + factory.creations);
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(Only_Constructed_Instances_Counted, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*, EveryThirdCreator>("everyThird");
+	for (int i = 0; i < 7; i++)
+		manager.getBean<DummyClass*>("everyThird");
+
+	const corm::BeanStatisticsEntry everyThird = findEntry(manager.getStatistics(), "everyThird");
+#ifndef DISABLE_CORM_STATISTICS
+	BOOST_CHECK_EQUAL(7u, everyThird.lookups);
+	BOOST_CHECK_EQUAL(3u, everyThird.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, everyThird.lookups + everyThird.creations);
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(Singleton_Counted_Once_Constructed, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<FailsAtFirst*>("failsAtFirst");
+	numFailuresLeft = 1;
+	BOOST_REQUIRE_THROW(manager.getBean<FailsAtFirst*>("failsAtFirst"), std::runtime_error);
+	manager.getBean<FailsAtFirst*>("failsAtFirst");
+	manager.getBean<FailsAtFirst*>("failsAtFirst");
+
+	// Only the construction which succeeded counts
+	const corm::BeanStatisticsEntry failsAtFirst = findEntry(manager.getStatistics(), "failsAtFirst");
+#ifndef DISABLE_CORM_STATISTICS
+	BOOST_CHECK_EQUAL(1u, failsAtFirst.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, failsAtFirst.creations);
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(Scoped_Counted_Once_Per_Scope, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*, corm::ScopedBeanCreator<DummyClass*>>("scoped");
+	for (int s = 0; s < 2; s++) {
+		corm::BeanScope scope;
+		for (int i = 0; i < 3; i++)
+			manager.getBean<DummyClass*>("scoped");
+	}
+
+	// Only the instance which each scope creates counts, not the retrievals thereof
+	const corm::BeanStatisticsEntry scoped = findEntry(manager.getStatistics(), "scoped");
+#ifndef DISABLE_CORM_STATISTICS
+	BOOST_CHECK_EQUAL(6u, scoped.lookups);
+	BOOST_CHECK_EQUAL(2u, scoped.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, scoped.lookups + scoped.creations);
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(Thread_Local_Counted_Once_Per_Thread, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*, corm::ThreadLocalBeanCreator<DummyClass*>>("threadLocal");
+	auto retrieve = [&manager]() {
+		for (int i = 0; i < 3; i++)
+			manager.getBean<DummyClass*>("threadLocal");
+	};
+	retrieve();
+	std::thread other(retrieve);
+	other.join();
+
+	// Only the instance which each thread creates counts, not the retrievals thereof
+	const corm::BeanStatisticsEntry threadLocal = findEntry(manager.getStatistics(), "threadLocal");
+#ifndef DISABLE_CORM_STATISTICS
+	BOOST_CHECK_EQUAL(6u, threadLocal.lookups);
+	BOOST_CHECK_EQUAL(2u, threadLocal.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, threadLocal.lookups + threadLocal.creations);
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(Pooled_Counted_Once_Per_Miss, StatisticsEnabled) {
+	corm::BeanManager manager;
+	manager.registerBean<corm::PooledBean<DummyClass>, corm::PooledBeanCreator<DummyClass>>("pooled");
+	for (int i = 0; i < 3; i++)
+		manager.getBean<corm::PooledBean<DummyClass>>("pooled");
+	corm::PooledBean<DummyClass> first = manager.getBean<corm::PooledBean<DummyClass>>("pooled");
+	corm::PooledBean<DummyClass> second = manager.getBean<corm::PooledBean<DummyClass>>("pooled");
+
+	// Only the misses of the pool construct an instance
+	const corm::BeanStatisticsEntry pooled = findEntry(manager.getStatistics(), "pooled");
+#ifndef DISABLE_CORM_STATISTICS
+	BOOST_CHECK_EQUAL(5u, pooled.lookups);
+	BOOST_CHECK_EQUAL(first.getPool()->getMisses(), pooled.creations);
+	BOOST_CHECK_EQUAL(2u, pooled.creations);
+#else
+	BOOST_CHECK_EQUAL(0u, pooled.lookups + pooled.creations);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(Not_Counted_When_Disabled) {
+	corm::BeanManager manager;
+	manager.registerBean<DummyClass*>("singleton");
+	manager.getBean<DummyClass*>("singleton");
+	BOOST_REQUIRE_THROW(manager.getBean<int>("singleton"), corm::InvalidBeanTypeException);
+
+	const corm::BeanStatisticsEntry singleton = findEntry(manager.getStatistics(), "singleton");
+	BOOST_CHECK_EQUAL(0u, singleton.lookups);
+	BOOST_CHECK_EQUAL(0u, singleton.typeMismatches);
+	BOOST_CHECK_EQUAL(0u, singleton.creations);
+	BOOST_CHECK_EQUAL(0, singleton.creationTime.count());
+}
+
+BOOST_AUTO_TEST_CASE(Write_Text_And_Json) {
+	std::vector<corm::BeanStatisticsEntry> statistics;
+	statistics.push_back(corm::BeanStatisticsEntry{"first", "int", 1, 2, 3, std::chrono::nanoseconds(4)});
+	statistics.push_back(corm::BeanStatisticsEntry{"second \"quoted\"", "DummyClass*", 5, 6, 7, std::chrono::nanoseconds(8)});
+
+	std::stringstream text;
+	corm::writeStatisticsText(text, statistics);
+	BOOST_CHECK_EQUAL("first (int): lookups=1 typeMismatches=2 creations=3 creationTime=4ns\n"
+			"second \"quoted\" (DummyClass*): lookups=5 typeMismatches=6 creations=7 creationTime=8ns\n", text.str());
+
+	std::stringstream json;
+	corm::writeStatisticsJson(json, statistics);
+	BOOST_CHECK_EQUAL("{\"beans\": [\n"
+			"  {\"name\": \"first\", \"type\": \"int\", \"lookups\": 1, \"typeMismatches\": 2, \"creations\": 3, \"creationTimeNs\": 4},\n"
+			"  {\"name\": \"second \\\"quoted\\\"\", \"type\": \"DummyClass*\", \"lookups\": 5, \"typeMismatches\": 6, \"creations\": 7, \"creationTimeNs\": 8}\n"
+			"]}\n", json.str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "corm/CircularDependencyChecker.h"
+
+typedef std::vector<std::string> Names;
+
+BOOST_AUTO_TEST_SUITE(CircularDependencyChecker_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(No_configs) {
+	corm::CircularDependencyChecker checker;
+	BOOST_CHECK(!checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle().empty());
+	BOOST_CHECK(checker.getCycles().empty());
+}
+
+BOOST_AUTO_TEST_CASE(No_cycle) {
+	corm::CircularDependencyChecker checker;
+	checker.add("A", Names{"b"}, Names{"a"});
+	checker.add("B", Names{"c", "external"}, Names{"b"});
+	checker.add("C", Names{}, Names{"c"});
+	BOOST_CHECK(!checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Simple_cycle) {
+	corm::CircularDependencyChecker checker;
+	checker.add("A", Names{"b"}, Names{"a"});
+	checker.add("B", Names{"a"}, Names{"b"});
+	BOOST_CHECK(checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle() == Names({"A::b", "B::a", "A::b"}));
+	BOOST_CHECK_EQUAL(1, checker.getCycles().size());
+}
+
+BOOST_AUTO_TEST_CASE(Self_dependency) {
+	corm::CircularDependencyChecker checker;
+	checker.add("A", Names{"other", "a"}, Names{"a"});
+	BOOST_CHECK(checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle() == Names({"A::a", "A::a"}));
+}
+
+BOOST_AUTO_TEST_CASE(Path_into_cycle_is_not_reported) {
+	// 1 -> 2 -> 3 -> 4 -> 3, where only 3 -> 4 -> 3 is the cycle
+	corm::CircularDependencyChecker checker;
+	checker.add("C1", Names{"r2"}, Names{"r1"});
+	checker.add("C2", Names{"r3"}, Names{"r2"});
+	checker.add("C3", Names{"r4"}, Names{"r3"});
+	checker.add("C4", Names{"r3"}, Names{"r4"});
+	BOOST_CHECK(checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle() == Names({"C3::r4", "C4::r3", "C3::r4"}));
+}
+
+BOOST_AUTO_TEST_CASE(Shortest_cycle_is_reported) {
+	// A is part of both A -> B -> C -> D -> A and A -> D -> A
+	corm::CircularDependencyChecker checker;
+	checker.add("A", Names{"b", "d"}, Names{"a"});
+	checker.add("B", Names{"c"}, Names{"b"});
+	checker.add("C", Names{"d"}, Names{"c"});
+	checker.add("D", Names{"a"}, Names{"d"});
+	BOOST_CHECK(checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle() == Names({"A::d", "D::a", "A::d"}));
+	BOOST_CHECK_EQUAL(1, checker.getCycles().size());
+}
+
+BOOST_AUTO_TEST_CASE(All_cycles_are_reported) {
+	corm::CircularDependencyChecker checker;
+	checker.add("A", Names{"b"}, Names{"a"});
+	checker.add("B", Names{"a"}, Names{"b"});
+	checker.add("Independent", Names{"a"}, Names{"i"});
+	checker.add("X", Names{"y"}, Names{"x"});
+	checker.add("Y", Names{"x"}, Names{"y"});
+	BOOST_CHECK(checker.checkForCycle());
+	BOOST_REQUIRE_EQUAL(2, checker.getCycles().size());
+	BOOST_CHECK(checker.getCycles()[0] == Names({"A::b", "B::a", "A::b"}));
+	BOOST_CHECK(checker.getCycles()[1] == Names({"X::y", "Y::x", "X::y"}));
+}
+
+BOOST_AUTO_TEST_CASE(Replacing_config) {
+	corm::CircularDependencyChecker checker;
+	checker.add("A", Names{"b"}, Names{"a"});
+	checker.add("B", Names{"a"}, Names{"b"});
+	checker.add("B", Names{}, Names{"b"});
+	BOOST_CHECK(!checker.checkForCycle());
+}
+
+BOOST_AUTO_TEST_CASE(Deep_chain) {
+	// Far deeper than what a recursive search could handle, with a cycle at the very end
+	const int numConfigs = 200000;
+	corm::CircularDependencyChecker checker;
+	for (int i = 0; i < numConfigs; i++)
+		checker.add("C" + std::to_string(i), Names{"r" + std::to_string(i + 1)}, Names{"r" + std::to_string(i)});
+	BOOST_CHECK(!checker.checkForCycle());
+
+	checker.add("Last", Names{"r" + std::to_string(numConfigs - 1)}, Names{"r" + std::to_string(numConfigs)});
+	BOOST_CHECK(checker.checkForCycle());
+	BOOST_CHECK(checker.getCycle() == Names({"C" + std::to_string(numConfigs - 1) + "::r" + std::to_string(numConfigs),
+			"Last::r" + std::to_string(numConfigs - 1), "C" + std::to_string(numConfigs - 1) + "::r" + std::to_string(numConfigs)}));
+}
+
+BOOST_AUTO_TEST_CASE(Layers_of_shared_paths) {
+	// Each config of a layer depends on every config of the next layer, which has an exponential number of paths
+	const int numLayers = 40;
+	const int layerWidth = 4;
+	corm::CircularDependencyChecker checker;
+	for (int l = 0; l < numLayers; l++) {
+		for (int w = 0; w < layerWidth; w++) {
+			Names resources;
+			for (int n = 0; n < layerWidth && l + 1 < numLayers; n++)
+				resources.push_back("b" + std::to_string(l + 1) + "_" + std::to_string(n));
+			checker.add("L" + std::to_string(l) + "_" + std::to_string(w), resources,
+					Names{"b" + std::to_string(l) + "_" + std::to_string(w)});
+		}
+	}
+	BOOST_CHECK(!checker.checkForCycle());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
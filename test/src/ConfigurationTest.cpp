@@ -57,4 +57,26 @@ BOOST_AUTO_TEST_CASE(Provider_and_Consumer) {
 	delete(consumer);
 }
 
+BOOST_AUTO_TEST_CASE(Provider_and_Ref_Consumer) {
+	corm::BeanManager manager;
+	corm::ConfigurationWrapper<RefConsumerTestConfig> consumerWrapper(&manager);
+	BOOST_CHECK(!consumerWrapper.areResourcesSatisfied());
+
+	corm::ConfigurationWrapper<ProviderTestConfig> providerWrapper(&manager);
+	ProviderTestConfig* provider = (ProviderTestConfig*) providerWrapper.buildConfig();
+	provider->initialize();
+
+	// The resources are declared as handles, which must resolve to the beans of the provider
+	BOOST_CHECK(consumerWrapper.areResourcesSatisfied());
+	RefConsumerTestConfig* consumer = (RefConsumerTestConfig*) consumerWrapper.buildConfig();
+	consumer->initialize();
+
+	BOOST_CHECK(consumer->getProviderDummyClassFactory().isResolved());
+	BOOST_CHECK_EQUAL(0, consumer->getProviderDummyClassFactory().get().getValue());
+	BOOST_CHECK_EQUAL(manager.getBean<DummyClass*>("providerDummyClassSingleton"), consumer->getProviderDummyClassSingleton().get());
+
+	delete(provider);
+	delete(consumer);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -4,12 +4,17 @@
 #endif
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 #include "corm/Context.h"
 
 #include "config/ContextTestConfigs.h"
 #include "config/ContextTestBeanMismatchConfigs.h"
 #include "config/ContextTestDependenctConfigs.h"
 #include "config/ContextTestCircularDependencyConfig.h"
+#include "config/ContextTestParallelConfigs.h"
+#include "config/ContextTestRuntimeConfigs.h"
+#include "performance/ChainConfig.h"
 
 BOOST_AUTO_TEST_SUITE(ConfigurationManager_Test_Suite)
 
@@ -78,6 +83,15 @@ BOOST_AUTO_TEST_CASE(Circular_Config_Dependency) {
 	corm::Context context;
 	context.registerConfiguration<CircularDep1TestConfig, CircularDep2TestConfig>();
 	BOOST_REQUIRE_THROW(context.assemble(), corm::ConfigurationCycleException);
+
+	// The minimal cycle must be reported
+	try {
+		context.assemble();
+		BOOST_FAIL("Cycle was not detected");
+	} catch (corm::ConfigurationCycleException& e) {
+		BOOST_CHECK_EQUAL("Configuration cycle detected [CircularDep1TestConfig::circularBean1, "
+				"CircularDep2TestConfig::circularBean2, CircularDep1TestConfig::circularBean1]", e.what());
+	}
 }
 
 BOOST_AUTO_TEST_CASE(Beans_External_To_Context) {
@@ -92,4 +106,145 @@ BOOST_AUTO_TEST_CASE(Beans_External_To_Context) {
 	BOOST_CHECK_EQUAL(0, intFromContext);
 }
 
+BOOST_AUTO_TEST_CASE(Chain_Registered_In_Reverse) {
+	corm::Context context;
+	registerChainConfigs<99>(context);
+	context.assemble();
+	BOOST_CHECK_EQUAL(0, context.getBean<int>("chain0"));
+	BOOST_CHECK_EQUAL(99, context.getBean<int>("chain99"));
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_Registered_Configurations) {
+	// Names which do not fit within the small string optimization, registered such that every configuration is
+	// waiting on the next one
+	const std::string prefix = "a.rather.long.runtime.bean.name.";
+	corm::Context context;
+	for (int i = 999; i >= 0; i--)
+		context.registerConfiguration(new RuntimeTestConfigWrapper(&context, prefix, i));
+	context.assemble();
+	BOOST_CHECK_EQUAL(0, context.getBean<int>(prefix + "0"));
+	BOOST_CHECK_EQUAL(999, context.getBean<int>(prefix + "999"));
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_Registered_Configuration_Missing_Resources) {
+	corm::Context context;
+	context.registerConfiguration(new RuntimeTestConfigWrapper(&context, "runtime", 1));
+	BOOST_REQUIRE_THROW(context.assemble(), corm::ConfigurationInitializationException);
+}
+
+BOOST_AUTO_TEST_CASE(Only_Remaining_Resources_Reported) {
+	corm::Context context;
+	context.registerConfiguration<SingleConfigMissingResourcesTestConfig>();
+	context.registerBeanInstance<int>("missingIntValue", 987);
+
+	try {
+		context.assemble();
+		BOOST_FAIL("Context assembled with missing resources");
+	} catch (corm::ConfigurationInitializationException& e) {
+		BOOST_CHECK_EQUAL("Unable to initialize configurations: [SingleConfigMissingResourcesTestConfig is missing resources "
+				"[missingStringReference]]", e.what());
+	}
+
+	// Providing the last resource allows the assembly to complete
+	std::string str = "Something or other";
+	context.registerBeanInstance<std::string&>("missingStringReference", str);
+	context.assemble();
+}
+
+BOOST_AUTO_TEST_CASE(Frozen_Context) {
+	std::string str = "Something or other";
+	corm::Context context;
+	context.registerConfiguration<SingleConfigMissingResourcesTestConfig, ProvideBean1Config>();
+	context.registerBeanInstance<int>("missingIntValue", 987);
+	context.registerBeanInstance<std::string&>("missingStringReference", str);
+	context.assemble();
+	context.freeze();
+
+	// All beans remain available, with the same instances as before
+	BOOST_CHECK_EQUAL(987, context.getBean<int>("missingIntValue"));
+	BOOST_CHECK_EQUAL(&str, &context.getBean<std::string&>("missingStringReference"));
+	BOOST_CHECK_EQUAL(0, context.getBean<int&>("DuplicateBean"));
+	BOOST_REQUIRE_THROW(context.getBean<double&>("DuplicateBean"), corm::InvalidBeanTypeException);
+
+	// But no configuration can add to it anymore
+	context.registerConfiguration<ProvideBean2Config>();
+	BOOST_REQUIRE_THROW(context.assemble(), corm::BeanManagerFrozenException);
+}
+
+BOOST_AUTO_TEST_CASE(Child_Context) {
+	corm::Context parent;
+	parent.registerConfiguration<ProviderConsumerManagerTestConfig, ProviderManagerTestConfig>();
+	parent.assemble();
+	parent.freeze();
+
+	// The child only loads its own configuration, the resources of which are provided by the parent
+	for (int i = 0; i < 3; i++) {
+		corm::Context child(&parent);
+		child.registerConfiguration<ConsumerManagerTestConfig>();
+		child.assemble();
+		BOOST_CHECK_EQUAL(parent.getBean<DummyClass*>("providerManagerDummySingleton"),
+				child.getBean<DummyClass*>("providerManagerDummySingleton"));
+	}
+
+	// Nor can a child provide a bean that the parent already does
+	corm::Context child(&parent);
+	child.registerConfiguration<ProviderManagerTestConfig>();
+	BOOST_REQUIRE_THROW(child.assemble(), corm::InvalidBeanNameException);
+}
+
+BOOST_AUTO_TEST_CASE(Thread_Local_Bean) {
+	corm::Context context;
+	context.registerConfiguration<ThreadLocalBeanConfig>();
+	context.assemble();
+
+	DummyClass* mine = context.getBean<DummyClass*>("threadLocalDummy");
+	BOOST_CHECK_EQUAL(mine, context.getBean<DummyClass*>("threadLocalDummy"));
+	DummyClass* other = NULL;
+	std::thread([&context, &other]() { other = context.getBean<DummyClass*>("threadLocalDummy"); }).join();
+	BOOST_CHECK(other != NULL);
+	BOOST_CHECK(other != mine);
+}
+
+BOOST_AUTO_TEST_CASE(Parallel_Independent_Configs) {
+	numStartedParallelConfigs = 0;
+	corm::Context context;
+	context.registerConfiguration<ParallelConsumerTestConfig, ParallelTestConfig<0>, ParallelTestConfig<1>,
+			ParallelTestConfig<2>, ParallelTestConfig<3>>();
+	context.assemble(numParallelConfigs);
+
+	// All of the parallel configurations must have been initializing at the same time
+	BOOST_CHECK(context.getBean<bool>("allParallel"));
+	BOOST_CHECK(context.getAssemblyTime() > std::chrono::steady_clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(Parallel_Chain) {
+	corm::Context context;
+	registerChainConfigs<99>(context);
+	context.assemble(4);
+	BOOST_CHECK_EQUAL(99, context.getBean<int>("chain99"));
+}
+
+BOOST_AUTO_TEST_CASE(Parallel_Exceptions) {
+	{
+		corm::Context context;
+		context.registerConfiguration<SingleConfigMissingResourcesTestConfig, ProvideBean1Config>();
+		BOOST_REQUIRE_THROW(context.assemble(4), corm::ConfigurationInitializationException);
+	}
+	{
+		corm::Context context;
+		context.registerConfiguration<CircularDep1TestConfig, CircularDep2TestConfig>();
+		BOOST_REQUIRE_THROW(context.assemble(4), corm::ConfigurationCycleException);
+	}
+	{
+		corm::Context context;
+		context.registerConfiguration<DummyBeanProviderTestConfig, DummyBeanAsIntConsumerTestConfig>();
+		BOOST_REQUIRE_THROW(context.assemble(4), corm::InvalidBeanTypeException);
+	}
+	{
+		corm::Context context;
+		context.registerConfiguration<ProvideBean1Config, FailingTestConfig>();
+		BOOST_REQUIRE_THROW(context.assemble(4), std::runtime_error);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "corm/FrozenBeanTable.h"
+#include "DummyClass.h"
+
+BOOST_AUTO_TEST_SUITE(FrozenBeanTable_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Empty_table) {
+	std::unique_ptr<corm::FrozenBeanTable> table(corm::FrozenBeanTable::build({}));
+	BOOST_REQUIRE(table != NULL);
+	BOOST_CHECK_EQUAL(0, table->size());
+	BOOST_CHECK(table->find("bean") == NULL);
+	BOOST_CHECK(table->find("") == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(Single_bean) {
+	corm::BeanInstanceProvider<int> provider(5);
+	std::unique_ptr<corm::FrozenBeanTable> table(corm::FrozenBeanTable::build({{"bean", &provider}}));
+	BOOST_REQUIRE(table != NULL);
+	BOOST_CHECK_EQUAL(1, table->size());
+
+	std::string name = "bean";
+	BOOST_CHECK_EQUAL(&provider, table->find(name));
+	BOOST_CHECK_EQUAL(&provider, table->find("bean"));
+
+	// Every name maps onto the one slot, so similar names must be rejected by the comparison
+	BOOST_CHECK(table->find("bea") == NULL);
+	BOOST_CHECK(table->find("beans") == NULL);
+	BOOST_CHECK(table->find("") == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(Long_names) {
+	// Names which are too long to be stored entirely within their slot, and only differ past that point
+	const std::string prefix = "a.very.long.prefix.which.is.shared.by.all.of.the.beans.";
+	corm::BeanInstanceProvider<int> provider1(1);
+	corm::BeanInstanceProvider<int> provider2(2);
+	std::unique_ptr<corm::FrozenBeanTable> table(corm::FrozenBeanTable::build({
+		{prefix + "bean1", &provider1}, {prefix + "bean2", &provider2}
+	}));
+	BOOST_REQUIRE(table != NULL);
+
+	BOOST_CHECK_EQUAL(&provider1, table->find(prefix + "bean1"));
+	BOOST_CHECK_EQUAL(&provider2, table->find(prefix + "bean2"));
+	BOOST_CHECK(table->find(prefix + "bean3") == NULL);
+	BOOST_CHECK(table->find(prefix) == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(Many_beans) {
+	const int numBeans = 5000;
+	std::vector<std::string> names;
+	std::vector<corm::BeanInstanceProvider<int>*> providers;
+	for (int i = 0; i < numBeans; i++) {
+		names.push_back("bean" + std::to_string(i));
+		providers.push_back(new corm::BeanInstanceProvider<int>(i));
+	}
+
+	// The table does not depend on the names outliving the build
+	std::vector<corm::FrozenBeanTable::Bean> beans;
+	for (int i = 0; i < numBeans; i++)
+		beans.emplace_back(names[i], providers[i]);
+	std::unique_ptr<corm::FrozenBeanTable> table(corm::FrozenBeanTable::build(beans));
+	names.clear();
+	beans.clear();
+
+	BOOST_REQUIRE(table != NULL);
+	BOOST_CHECK_EQUAL(numBeans, table->size());
+	for (int i = 0; i < numBeans; i++)
+		BOOST_CHECK_EQUAL(providers[i], table->find("bean" + std::to_string(i)));
+	for (int i = numBeans; i < 2 * numBeans; i++)
+		BOOST_CHECK(table->find("bean" + std::to_string(i)) == NULL);
+
+	for (corm::BeanInstanceProvider<int>* p: providers)
+		delete(p);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "corm/BeanManager.h"
+#include "corm/IntrusivePtr.h"
+
+// Number of beans that currently exist
+static int numCounted = 0;
+
+/*
+ * Bean which counts its own references atomically.
+ */
+struct SharedCounted: public corm::RefCounted<SharedCounted> {
+	SharedCounted() {
+		numCounted++;
+	}
+	~SharedCounted() {
+		numCounted--;
+	}
+
+	int value = 0;
+};
+
+/*
+ * Bean which counts its own references without atomic operations.
+ */
+struct LocalCounted: public corm::RefCounted<LocalCounted, corm::LocalRefCount> {
+	LocalCounted() {
+		numCounted++;
+	}
+	~LocalCounted() {
+		numCounted--;
+	}
+};
+
+BOOST_AUTO_TEST_SUITE(IntrusivePtr_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(References_Counted) {
+	numCounted = 0;
+	{
+		corm::IntrusivePtr<LocalCounted> first(new LocalCounted());
+		BOOST_CHECK_EQUAL(1, first->getRefCount());
+		{
+			corm::IntrusivePtr<LocalCounted> second = first;
+			BOOST_CHECK(first == second);
+			BOOST_CHECK_EQUAL(2, first->getRefCount());
+
+			corm::IntrusivePtr<LocalCounted> third(std::move(second));
+			BOOST_CHECK(!second);
+			BOOST_CHECK_EQUAL(2, first->getRefCount());
+		}
+		BOOST_CHECK_EQUAL(1, first->getRefCount());
+		BOOST_CHECK_EQUAL(1, numCounted);
+
+		// Releasing the last reference destroys the bean
+		first.reset();
+		BOOST_CHECK(first.get() == NULL);
+		BOOST_CHECK_EQUAL(0, numCounted);
+
+		first.reset(new LocalCounted());
+		BOOST_CHECK_EQUAL(1, numCounted);
+	}
+	BOOST_CHECK_EQUAL(0, numCounted);
+}
+
+BOOST_AUTO_TEST_CASE(Assignment) {
+	numCounted = 0;
+	corm::IntrusivePtr<SharedCounted> first(new SharedCounted());
+	corm::IntrusivePtr<SharedCounted> second(new SharedCounted());
+	BOOST_CHECK_EQUAL(2, numCounted);
+
+	second = first;
+	BOOST_CHECK_EQUAL(1, numCounted);
+	BOOST_CHECK_EQUAL(2, first->getRefCount());
+
+	// Assigning to itself keeps the reference
+	second = second;
+	BOOST_CHECK_EQUAL(2, first->getRefCount());
+
+	// The count is not copied along with the bean
+	SharedCounted copy(*first);
+	BOOST_CHECK_EQUAL(0, copy.getRefCount());
+}
+
+BOOST_AUTO_TEST_CASE(Shared_Between_Threads) {
+	numCounted = 0;
+	const int numThreads = 8;
+	const int numCopies = 10000;
+	{
+		corm::IntrusivePtr<SharedCounted> bean(new SharedCounted());
+		std::vector<std::thread> threads;
+		for (int t = 0; t < numThreads; t++) {
+			threads.emplace_back([bean]() {
+				for (int i = 0; i < numCopies; i++) {
+					corm::IntrusivePtr<SharedCounted> copy = bean;
+				}
+			});
+		}
+		for (std::thread& t: threads)
+			t.join();
+		BOOST_CHECK_EQUAL(1, bean->getRefCount());
+	}
+	BOOST_CHECK_EQUAL(0, numCounted);
+}
+
+BOOST_AUTO_TEST_CASE(Intrusive_Beans_Through_Manager) {
+	numCounted = 0;
+	{
+		corm::BeanManager manager;
+		manager.registerBean<corm::IntrusivePtr<SharedCounted>, corm::SmartSingletonBeanCreator<SharedCounted, corm::IntrusivePtr>>("singleton");
+		manager.registerBean<corm::IntrusivePtr<LocalCounted>, corm::SmartFactoryBeanCreator<LocalCounted, corm::IntrusivePtr>>("factory");
+
+		corm::IntrusivePtr<SharedCounted> singleton = manager.getBean<corm::IntrusivePtr<SharedCounted>>("singleton");
+		BOOST_CHECK(singleton == manager.getBean<corm::IntrusivePtr<SharedCounted>>("singleton"));
+		// Referenced by the creator, and the retrieved pointer
+		BOOST_CHECK_EQUAL(2, singleton->getRefCount());
+
+		corm::IntrusivePtr<LocalCounted> product = manager.getBean<corm::IntrusivePtr<LocalCounted>>("factory");
+		BOOST_CHECK(product != manager.getBean<corm::IntrusivePtr<LocalCounted>>("factory"));
+		BOOST_CHECK_EQUAL(1, product->getRefCount());
+		BOOST_CHECK_EQUAL(2, numCounted);
+	}
+	BOOST_CHECK_EQUAL(0, numCounted);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
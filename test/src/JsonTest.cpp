@@ -0,0 +1,29 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+#include "corm/Json.h"
+
+BOOST_AUTO_TEST_SUITE(Json_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Plain_String_Is_Quoted) {
+	std::stringstream json;
+	corm::writeJsonString(json, "someBean");
+	BOOST_CHECK_EQUAL("\"someBean\"", json.str());
+}
+
+BOOST_AUTO_TEST_CASE(Special_Characters_Are_Escaped) {
+	std::stringstream json;
+	corm::writeJsonString(json, "a\"b\\c\nd\x1f");
+	BOOST_CHECK_EQUAL("\"a\\\"b\\\\c\\u000ad\\u001f\"", json.str());
+
+	// The formatting of the stream is left as it was
+	json << 42;
+	BOOST_CHECK_EQUAL("\"a\\\"b\\\\c\\u000ad\\u001f\"42", json.str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,14 +5,28 @@
 #include <boost/test/unit_test.hpp>
 
 #include "corm/Context.h"
+#include <atomic>
 #include <chrono>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "performance/ChainConfig.h"
 #include "performance/RuntimeConfig.h"
+#include "performance/SlowConfig.h"
 #include "performance/SimpleConfig.h"
 #include "performance/NoConfig.h"
 
 int numOfReps =  100000;
+// Number of beans and lookup passes for the large registry lookup tests
+int numOfLookupBeans = 20000;
+int numOfLookupPasses = 100;
+// Number of configurations in the chain, and number of times that the chain is assembled
+const int numOfChainConfigs = 500;
+int numOfChainReps = 20;
+// Number of lookups performed by each thread for the concurrent lookup tests
+int numOfConcurrentLookups = 2000000;
 
 // Helper to get the current time stamp in milliseconds
 long getCurrentTimeMillis() {
@@ -42,6 +56,45 @@ BOOST_AUTO_TEST_CASE(Test_Runtime_Corm) {
 	printResult("Runtime CORM", start, end);
 }
 
+BOOST_AUTO_TEST_CASE(Test_Runtime_Corm_Child) {
+	corm::Context parent;
+	parent.registerConfiguration<RootRuntimeConfig>();
+	parent.assemble();
+	parent.freeze();
+
+	long start = getCurrentTimeMillis();
+	for (int i = 0; i < numOfReps; i++) {
+		corm::Context context(&parent);
+		context.registerConfiguration<RequestRuntimeConfig>();
+		context.assemble();
+	}
+	long end = getCurrentTimeMillis();
+	printResult("Runtime CORM child context", start, end);
+}
+
+BOOST_AUTO_TEST_CASE(Test_Chain_Assembly) {
+	long start = getCurrentTimeMillis();
+	for (int i = 0; i < numOfChainReps; i++) {
+		corm::Context context;
+		registerChainConfigs<numOfChainConfigs - 1>(context);
+		context.assemble();
+		BOOST_CHECK_EQUAL(numOfChainConfigs - 1, context.getBean<int>("chain" + std::to_string(numOfChainConfigs - 1)));
+	}
+	long end = getCurrentTimeMillis();
+	printResult("Chain of " + std::to_string(numOfChainConfigs) + " configurations", start, end);
+}
+
+BOOST_AUTO_TEST_CASE(Test_Parallel_Assembly) {
+	const int numOfSlowConfigs = 8;
+	for (unsigned int numThreads: {1, 2, 4, 8}) {
+		corm::Context context;
+		registerSlowConfigs<numOfSlowConfigs - 1>(context);
+		context.assemble(numThreads);
+		std::cerr << "Assembly of " << numOfSlowConfigs << " slow configurations with " << numThreads << " thread(s) completed in "
+				<< std::chrono::duration<double>(context.getAssemblyTime()).count() << " s" << std::endl;
+	}
+}
+
 BOOST_AUTO_TEST_CASE(Test_Simple_Corm) {
 	long start = getCurrentTimeMillis();
 	for (int i = 0; i < numOfReps; i++) {
@@ -64,4 +117,94 @@ BOOST_AUTO_TEST_CASE(Test_No_Config) {
 
 }
 
+BOOST_AUTO_TEST_CASE(Test_Large_Registry_Lookup) {
+	corm::BeanManager manager;
+	std::vector<std::string> names;
+	for (int i = 0; i < numOfLookupBeans; i++)
+		names.push_back("some.module.bean_" + std::to_string(i));
+
+	long start = getCurrentTimeMillis();
+	for (const std::string& name: names)
+		manager.registerBeanInstance<int>(name, 1);
+	long end = getCurrentTimeMillis();
+	printResult("Register " + std::to_string(numOfLookupBeans) + " beans", start, end);
+
+	// Lookup by std::string
+	int sum = 0;
+	start = getCurrentTimeMillis();
+	for (int pass = 0; pass < numOfLookupPasses; pass++) {
+		for (const std::string& name: names)
+			sum += manager.getBean<int>(name);
+	}
+	end = getCurrentTimeMillis();
+	printResult("Lookup by std::string", start, end);
+
+	// Lookup by const char*
+	start = getCurrentTimeMillis();
+	for (int pass = 0; pass < numOfLookupPasses; pass++) {
+		for (const std::string& name: names)
+			sum += manager.getBean<int>(name.c_str());
+	}
+	end = getCurrentTimeMillis();
+	printResult("Lookup by const char*", start, end);
+
+	// Lookup through pre-resolved handles
+	std::vector<corm::BeanRef<int>> refs;
+	for (const std::string& name: names)
+		refs.push_back(manager.getBeanRef<int>(name));
+	start = getCurrentTimeMillis();
+	for (int pass = 0; pass < numOfLookupPasses; pass++) {
+		for (const corm::BeanRef<int>& ref: refs)
+			sum += ref.get();
+	}
+	end = getCurrentTimeMillis();
+	printResult("Lookup by BeanRef", start, end);
+
+	// Lookup by std::string, once frozen
+	start = getCurrentTimeMillis();
+	manager.freeze();
+	end = getCurrentTimeMillis();
+	printResult("Freeze " + std::to_string(numOfLookupBeans) + " beans", start, end);
+	start = getCurrentTimeMillis();
+	for (int pass = 0; pass < numOfLookupPasses; pass++) {
+		for (const std::string& name: names)
+			sum += manager.getBean<int>(name);
+	}
+	end = getCurrentTimeMillis();
+	printResult("Lookup by std::string (frozen)", start, end);
+
+	BOOST_CHECK_EQUAL(4 * numOfLookupBeans * numOfLookupPasses, sum);
+}
+
+BOOST_AUTO_TEST_CASE(Test_Concurrent_Lookup) {
+	corm::Context context;
+	context.registerConfiguration<RootRuntimeConfig>();
+	context.assemble();
+
+	// Scale the number of reader threads which are retrieving beans from the assembled context
+	for (unsigned int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+		std::vector<std::thread> readers;
+		std::atomic<long> numValid(0);
+		long start = getCurrentTimeMillis();
+		for (unsigned int t = 0; t < numThreads; t++) {
+			readers.emplace_back([&context, &numValid]() {
+				long valid = 0;
+				for (int i = 0; i < numOfConcurrentLookups; i++) {
+					valid += context.getBean<DummyClass*>("dummySingleton") != NULL;
+					valid += 123 == context.getBean<int&>("int1");
+				}
+				numValid += valid;
+			});
+		}
+		for (std::thread& t: readers)
+			t.join();
+		long end = getCurrentTimeMillis();
+		BOOST_CHECK_EQUAL(2L * numOfConcurrentLookups * numThreads, numValid.load());
+
+		double seconds = (end - start) / 1000.0;
+		std::cerr << numThreads << " reader thread(s): " << (2.0 * numOfConcurrentLookups * numThreads / seconds / 1e6)
+				<< " M lookups/s (" << seconds << " s)" << std::endl;
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+#define BOOST_TEST_DYN_LINK
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#endif
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "corm/Context.h"
+#include "corm/Trace.h"
+#include "config/ContextTestRuntimeConfigs.h"
+#include "DummyClass.h"
+
+/*
+ * Helper which counts how often the text occurs within the string.
+ */
+static int countOccurrences(const std::string& str, const std::string& text) {
+	int count = 0;
+	for (std::size_t pos = str.find(text); pos != std::string::npos; pos = str.find(text, pos + text.size()))
+		count++;
+	return count;
+}
+
+/*
+ * Helper which reads the entire file.
+ */
+static std::string readFile(const std::string& path) {
+	std::ifstream in(path);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	return ss.str();
+}
+
+BOOST_AUTO_TEST_SUITE(Trace_Test_Suite)
+
+BOOST_AUTO_TEST_CASE(Assembly_Traced) {
+	const std::string path = (std::filesystem::temp_directory_path() / "corm_trace_test.json").string();
+	corm::Trace::start(path);
+	BOOST_CHECK(corm::Trace::isEnabled());
+	{
+		corm::Context context;
+		for (int i = 2; i >= 0; i--)
+			context.registerConfiguration(new RuntimeTestConfigWrapper(&context, "traced", i));
+		context.registerBean<DummyClass*>("tracedBean");
+		context.assemble();
+		context.getBean<DummyClass*>("tracedBean");
+		context.getBean<DummyClass*>("tracedBean");
+	}
+	BOOST_CHECK(corm::Trace::stop());
+	BOOST_CHECK(!corm::Trace::isEnabled());
+
+	const std::string trace = readFile(path);
+	std::filesystem::remove(path);
+	BOOST_CHECK_EQUAL(0u, trace.find("{\"traceEvents\": ["));
+	BOOST_CHECK_EQUAL(countOccurrences(trace, "\"ph\": \"B\""), countOccurrences(trace, "\"ph\": \"E\""));
+#ifdef ENABLE_CORM_TRACING
+	BOOST_CHECK_EQUAL(1, countOccurrences(trace, "\"name\": \"assemble\""));
+	BOOST_CHECK_EQUAL(1, countOccurrences(trace, "\"name\": \"RuntimeTestConfig0\""));
+	BOOST_CHECK_EQUAL(1, countOccurrences(trace, "\"name\": \"RuntimeTestConfig2\""));
+	BOOST_CHECK_EQUAL(3, countOccurrences(trace, "\"name\": \"postInit\""));
+	BOOST_CHECK_EQUAL(3, countOccurrences(trace, "\"name\": \"provideBeans\""));
+	// Only the first retrieval creates the bean
+	BOOST_CHECK_EQUAL(1, countOccurrences(trace, "\"name\": \"tracedBean\""));
+#else
+	// Nothing is recorded when the instrumentation is compiled out
+	BOOST_CHECK_EQUAL(0, countOccurrences(trace, "\"ph\""));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(Nothing_Traced_When_Stopped) {
+	const std::string path = (std::filesystem::temp_directory_path() / "corm_trace_stopped_test.json").string();
+	corm::Trace::start(path);
+	BOOST_CHECK(corm::Trace::stop());
+
+	// Assembling after stopping leaves the recording untouched
+	corm::Context context;
+	context.registerConfiguration(new RuntimeTestConfigWrapper(&context, "stopped", 0));
+	context.assemble();
+	BOOST_CHECK_EQUAL(0, countOccurrences(readFile(path), "\"ph\""));
+	std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()